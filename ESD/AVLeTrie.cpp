@@ -3,7 +3,13 @@
 #include <string.h>
 #include <stdbool.h>
 #include <math.h>
-#define ALPHABET_SIZE 128
+#include "leitor_csv.h"
+#include "snapshot_fdb.h"
+#include "arvore_radix.h"
+#include <stddef.h>
+
+// Layout antigo da trie, um no por caractere: children[128] + transacao
+#define BYTES_NO_TRIE_ANTIGA (128 * sizeof(void*) + sizeof(void*))
 
 typedef struct {
     char transaction_id[16];
@@ -17,10 +23,10 @@ typedef struct {
     char device_used[16];
 } Transaction;
 
-typedef struct TrieNode {
-    struct TrieNode* children[ALPHABET_SIZE];
-    Transaction* transacao;
-} TrieNode;
+// Trie radix adaptativa (arvore_radix.h) indexada pelo transaction_id: os
+// nos tem 4, 16, 48 ou 256 filhos conforme precisam e trechos sem bifurcacao
+// ficam comprimidos num so no. Nos e transacoes ficam nas arenas da arvore.
+typedef ArvoreRadix Trie;
 
 typedef struct Grupo {
     char chave[64];
@@ -29,56 +35,22 @@ typedef struct Grupo {
     struct Grupo* prox;
 } Grupo;
 
-TrieNode* create_trie_node() {
-    TrieNode* node = (TrieNode*)malloc(sizeof(TrieNode));
-    for (int i = 0; i < ALPHABET_SIZE; i++) node->children[i] = NULL;
-    node->transacao = NULL;
-    return node;
+Trie* create_trie() {
+    Trie* trie = (Trie*)malloc(sizeof(Trie));
+    radix_iniciar(trie, sizeof(Transaction), offsetof(Transaction, transaction_id));
+    return trie;
 }
 //Inserção de uma nova transação
-void insert_trie(TrieNode* root, Transaction t) {
-    TrieNode* curr = root;
-    for (int i = 0; t.transaction_id[i]; i++) {
-        unsigned char c = t.transaction_id[i];
-        if (!curr->children[c])
-            curr->children[c] = create_trie_node();
-        curr = curr->children[c];
-    }
-    curr->transacao = (Transaction*)malloc(sizeof(Transaction));
-    *(curr->transacao) = t;
+void insert_trie(Trie* trie, Transaction t) {
+    radix_inserir(trie, &t); // ID repetido: a nova substitui a antiga
 }
 //Busca de transação por ID
-Transaction* search_trie(TrieNode* root, const char* id) {
-    TrieNode* curr = root;
-    for (int i = 0; id[i]; i++) {
-        unsigned char c = id[i];
-        if (!curr->children[c]) return NULL;
-        curr = curr->children[c];
-    }
-    return curr->transacao;
+Transaction* search_trie(Trie* trie, const char* id) {
+    return (Transaction*)radix_buscar(trie, id);
 }
 //Remoção de transação por ID
-bool delete_trie(TrieNode* root, const char* id, int depth) {
-    if (!root) return false;
-    if (id[depth] == '\0') {
-        if (root->transacao) {
-            free(root->transacao);
-            root->transacao = NULL;
-            for (int i = 0; i < ALPHABET_SIZE; i++)
-                if (root->children[i]) return false;
-            return true;
-        }
-        return false;
-    }
-    unsigned char c = id[depth];
-    if (delete_trie(root->children[c], id, depth + 1)) {
-        free(root->children[c]);
-        root->children[c] = NULL;
-        for (int i = 0; i < ALPHABET_SIZE; i++)
-            if (root->children[i]) return false;
-        return !root->transacao;
-    }
-    return false;
+bool delete_trie(Trie* trie, const char* id) {
+    return radix_remover(trie, id);
 }
 
 void inserir_grupo(Grupo** lista, const char* chave, float valor) {
@@ -99,11 +71,10 @@ void inserir_grupo(Grupo** lista, const char* chave, float valor) {
     *lista = novo;
 }
 //Agrupamento dos dados por campo
-void agrupar_feature_trie(TrieNode* root, Grupo** lista, int feature) {
-    if (!root) return;
-    if (root->transacao) {
+void agrupar_feature_trie(Trie* trie, Grupo** lista, int feature) {
+    CursorRadix c;
+    for (Transaction* t = (Transaction*)radix_primeiro(&c, trie); t; t = (Transaction*)radix_proximo(&c)) {
         const char* chave = NULL;
-        Transaction* t = root->transacao;
         switch (feature) {
             case 1: chave = t->transaction_type; break;
             case 2: chave = t->merchant_category; break;
@@ -115,9 +86,6 @@ void agrupar_feature_trie(TrieNode* root, Grupo** lista, int feature) {
         }
         inserir_grupo(lista, chave, t->amount);
     }
-    for (int i = 0; i < ALPHABET_SIZE; i++)
-        if (root->children[i])
-            agrupar_feature_trie(root->children[i], lista, feature);
 }
 
 void imprimir_grupos(const char* nome, Grupo* lista) {
@@ -131,25 +99,33 @@ void imprimir_grupos(const char* nome, Grupo* lista) {
 bool prever_fraude(Transaction* t) {
     return (t->amount > 10000 || strcmp(t->device_used, "unknown") == 0);
 }
+//Conversao de uma linha do CSV para Transaction
+bool converter_linha(const LinhaCSV* linha, void* destino) {
+    Transaction* t = (Transaction*)destino;
+    if (!csv_linha_completa(linha)) return false; // Mesmo criterio do snapshot (fdb_gravar)
+    CSV_COPIAR(t->transaction_id, linha->campos[CAMPO_ID]);
+    CSV_COPIAR(t->timestamp, linha->campos[CAMPO_TIMESTAMP]);
+    CSV_COPIAR(t->sender_account, linha->campos[CAMPO_SENDER]);
+    CSV_COPIAR(t->receiver_account, linha->campos[CAMPO_RECEIVER]);
+    t->amount = csv_linha_amount(linha);
+    CSV_COPIAR(t->transaction_type, linha->campos[CAMPO_TIPO]);
+    CSV_COPIAR(t->merchant_category, linha->campos[CAMPO_CATEGORIA]);
+    CSV_COPIAR(t->location, linha->campos[CAMPO_LOCAL]);
+    CSV_COPIAR(t->device_used, linha->campos[CAMPO_DISPOSITIVO]);
+    return true;
+}
+
+void inserir_registro(void* registro, void* contexto) {
+    insert_trie((Trie*)contexto, *(Transaction*)registro);
+}
 //Leitura do Dataset
-TrieNode* load_csv_trie(const char* filename) {
-    TrieNode* root = create_trie_node();
-    FILE* file = fopen(filename, "r");
-    if (!file) {
+Trie* load_csv_trie(const char* filename) {
+    Trie* trie = create_trie();
+    if (!fdb_carregar_ou_gerar(filename, sizeof(Transaction), converter_linha, inserir_registro, trie, CSV_THREADS_AUTO)) {
         perror("Erro ao abrir o arquivo");
         exit(1);
     }
-    char line[512];
-    fgets(line, sizeof(line), file);
-    while (fgets(line, sizeof(line), file)) {
-        Transaction t;
-        sscanf(line, "%15[^,],%31[^,],%31[^,],%31[^,],%f,%15[^,],%31[^,],%31[^,],%15[^,],%*s",
-               t.transaction_id, t.timestamp, t.sender_account, t.receiver_account, &t.amount,
-               t.transaction_type, t.merchant_category, t.location, t.device_used);
-        insert_trie(root, t);
-    }
-    fclose(file);
-    return root;
+    return trie;
 }
 
 void remover_quebra(char* s) {
@@ -163,25 +139,17 @@ typedef struct {
     int count;
 } Estatisticas;
 //Cálculos estatísticos
-void calcular_estatisticas_trie(TrieNode* root, Estatisticas* est) {
-    if (!root) return;
-    if (root->transacao) {
-        float valor = root->transacao->amount;
-        est->soma += valor;
-        est->soma_quadrados += valor * valor;
-        est->count++;
-        if (valor < est->min) est->min = valor;
-        if (valor > est->max) est->max = valor;
-    }
-    for (int i = 0; i < ALPHABET_SIZE; i++) {
-        if (root->children[i])
-            calcular_estatisticas_trie(root->children[i], est);
-    }
-}
-
-void exibir_estatisticas_trie(TrieNode* root) {
+void exibir_estatisticas_trie(Trie* trie) {
     Estatisticas est = {0, 0, INFINITY, -INFINITY, 0};
-    calcular_estatisticas_trie(root, &est);
+    CursorRadix c;
+    for (Transaction* t = (Transaction*)radix_primeiro(&c, trie); t; t = (Transaction*)radix_proximo(&c)) {
+        float valor = t->amount;
+        est.soma += valor;
+        est.soma_quadrados += valor * valor;
+        est.count++;
+        if (valor < est.min) est.min = valor;
+        if (valor > est.max) est.max = valor;
+    }
     if (est.count == 0) {
         printf("Nenhuma transacao registrada.\n");
         return;
@@ -218,13 +186,10 @@ void adicionar_transacao(ListaTransacoes* lt, Transaction* t) {
     lt->lista[lt->tamanho++] = t;
 }
 
-void coletar_transacoes_trie(TrieNode* root, ListaTransacoes* lt) {
-    if (!root) return;
-    if (root->transacao)
-        adicionar_transacao(lt, root->transacao);
-    for (int i = 0; i < ALPHABET_SIZE; i++)
-        if (root->children[i])
-            coletar_transacoes_trie(root->children[i], lt);
+void coletar_transacoes_trie(Trie* trie, ListaTransacoes* lt) {
+    CursorRadix c;
+    for (Transaction* t = (Transaction*)radix_primeiro(&c, trie); t; t = (Transaction*)radix_proximo(&c))
+        adicionar_transacao(lt, t);
 }
 
 bool corresponde_filtro(Transaction* t, int campo, const char* valor) {
@@ -262,10 +227,10 @@ void exibir_transacao(Transaction* t) {
            t->location, t->device_used, prever_fraude(t) ? "Sim" : "Nao");
 }
 //Filtragem e ordenação dos dados
-void filtrar_e_ordenar_trie(TrieNode* root) {
+void filtrar_e_ordenar_trie(Trie* trie) {
     ListaTransacoes lt;
     inicializar_lista(&lt);
-    coletar_transacoes_trie(root, &lt);
+    coletar_transacoes_trie(trie, &lt);
 
     if (lt.tamanho == 0) {
         printf("Nenhuma transacao encontrada.\n");
@@ -315,19 +280,79 @@ void filtrar_e_ordenar_trie(TrieNode* root) {
     free(filtradas.lista);
 }
 
+// Prefixos distintos dos IDs, percorridos em ordem: cada ID acrescenta os
+// caracteres alem do prefixo que divide com o anterior
+typedef struct {
+    char anterior[16];
+    size_t prefixos;
+} ContextoPrefixos;
+
+void contar_prefixos(void* registro, void* contexto) {
+    ContextoPrefixos* ctx = (ContextoPrefixos*)contexto;
+    const char* id = ((Transaction*)registro)->transaction_id;
+    size_t comum = 0;
+    while (id[comum] && id[comum] == ctx->anterior[comum]) comum++;
+    ctx->prefixos += strlen(id) - comum;
+    memcpy(ctx->anterior, id, sizeof(ctx->anterior)); // transaction_id tem os mesmos 16 bytes
+}
+
+// Memoria do indice (sem as transacoes) contra a trie de 128 filhos por no,
+// que tinha um no por prefixo distinto mais a raiz
+void exibir_memoria_trie(Trie* trie) {
+    if (trie->quantidade == 0) {
+        printf("Nenhuma transacao registrada.\n");
+        return;
+    }
+    ContextoPrefixos ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    radix_para_cada(trie, contar_prefixos, &ctx);
+    size_t bytes_radix = radix_memoria(trie);
+    size_t bytes_antiga = (ctx.prefixos + 1) * BYTES_NO_TRIE_ANTIGA;
+
+    printf("\n=== Memoria do Indice ===\n");
+    printf("IDs: %zu\n", trie->quantidade);
+    printf("Nos: %zu No4 | %zu No16 | %zu No48 | %zu No256\n",
+           (size_t)trie->nos[RADIX_NO4].vivos, (size_t)trie->nos[RADIX_NO16].vivos,
+           (size_t)trie->nos[RADIX_NO48].vivos, (size_t)trie->nos[RADIX_NO256].vivos);
+    printf("Trie radix: %.2f MB (%.1f bytes por ID)\n", bytes_radix / (1024.0 * 1024.0), (double)bytes_radix / trie->quantidade);
+    printf("Trie antiga: %.2f MB (%.1f bytes por ID, %zu nos de %zu bytes)\n", bytes_antiga / (1024.0 * 1024.0),
+           (double)bytes_antiga / trie->quantidade, ctx.prefixos + 1, (size_t)BYTES_NO_TRIE_ANTIGA);
+    printf("Transacoes (arena de registros): %.2f MB\n", radix_arena_memoria(&trie->registros) / (1024.0 * 1024.0));
+}
+
+// Consultas por faixa de IDs: o callback mostra cada transacao assim que a
+// arvore a encontra, sem montar uma lista antes
+void exibir_resumo(void* registro, void* contexto) {
+    Transaction* t = (Transaction*)registro;
+    (*(int*)contexto)++;
+    printf("ID: %s | Valor: %.2f | Tipo: %s | Data: %s\n", t->transaction_id, t->amount, t->transaction_type, t->timestamp);
+}
+
+void buscar_prefixo_trie(Trie* trie, const char* prefixo) {
+    int encontradas = 0;
+    radix_para_cada_prefixo(trie, prefixo, exibir_resumo, &encontradas);
+    printf("%d transacao(oes) com ID iniciando em \"%s\".\n", encontradas, prefixo);
+}
+
+void buscar_intervalo_trie(Trie* trie, const char* inicio, const char* fim) {
+    int encontradas = 0;
+    radix_para_cada_intervalo(trie, inicio, fim, exibir_resumo, &encontradas);
+    printf("%d transacao(oes) com ID entre %s e %s.\n", encontradas, inicio, fim);
+}
+
 int main() {
-    TrieNode* root = load_csv_trie("C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv");
+    Trie* trie = load_csv_trie("C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv");
     int opcao;
     char id[16];
 
     do {
         printf("\n=== MENU TRIE ===\n");
-        printf("1. Buscar\n2. Remover\n3. Inserir\n4. Agrupar\n5. Estatisticas\n6. Filtrar e Ordenar\n7. Sair\nOpcao: ");
+        printf("1. Buscar\n2. Remover\n3. Inserir\n4. Agrupar\n5. Estatisticas\n6. Filtrar e Ordenar\n7. Sair\n8. Memoria do indice\n9. Buscar por prefixo do ID\n10. Buscar por intervalo de IDs\nOpcao: ");
         scanf("%d", &opcao); getchar();
 
         if (opcao == 1) {
             printf("ID: "); fgets(id, sizeof(id), stdin); remover_quebra(id);
-            Transaction* t = search_trie(root, id);
+            Transaction* t = search_trie(trie, id);
             if (t)
                 printf("ID: %s\nTimestamp: %s\nSender: %s\nReceiver: %s\nValor: %.2f\nTipo: %s\nCategoria: %s\nLocal: %s\nDispositivo: %s\nPrev. Fraude: %s\n",
                        t->transaction_id, t->timestamp, t->sender_account, t->receiver_account,
@@ -338,8 +363,10 @@ int main() {
 
         } else if (opcao == 2) {
             printf("ID: "); fgets(id, sizeof(id), stdin); remover_quebra(id);
-            delete_trie(root, id, 0);
-            printf("Remocao concluida.\n");
+            if (delete_trie(trie, id))
+                printf("Remocao concluida.\n");
+            else
+                printf("Nao encontrada.\n");
 
         } else if (opcao == 3) {
             Transaction t;
@@ -353,26 +380,41 @@ int main() {
             printf("Categoria: "); fgets(t.merchant_category, sizeof(t.merchant_category), stdin); remover_quebra(t.merchant_category);
             printf("Local: "); fgets(t.location, sizeof(t.location), stdin); remover_quebra(t.location);
             printf("Dispositivo: "); fgets(t.device_used, sizeof(t.device_used), stdin); remover_quebra(t.device_used);
-            insert_trie(root, t);
+            insert_trie(trie, t);
             printf("Inserida com sucesso.\n");
 
         } else if (opcao == 4) {
             printf("Agrupar por:\n1. Tipo\n2. Categoria\n3. Local\n4. Dispositivo\n5. Sender\n6. Receiver\nEscolha: ");
             int f; scanf("%d", &f); getchar();
             Grupo* grupos = NULL;
-            agrupar_feature_trie(root, &grupos, f);
+            agrupar_feature_trie(trie, &grupos, f);
             const char* nomes[] = {"", "Tipo", "Categoria", "Local", "Dispositivo", "Sender", "Receiver"};
             imprimir_grupos(nomes[f], grupos);
         }
         else if (opcao == 5) {
-           exibir_estatisticas_trie(root);
+           exibir_estatisticas_trie(trie);
         }
         else if (opcao == 6) {
-           filtrar_e_ordenar_trie(root);
+           filtrar_e_ordenar_trie(trie);
+        }
+        else if (opcao == 8) {
+           exibir_memoria_trie(trie);
+        }
+        else if (opcao == 9) {
+            printf("Prefixo: "); fgets(id, sizeof(id), stdin); remover_quebra(id);
+            buscar_prefixo_trie(trie, id);
+        }
+        else if (opcao == 10) {
+            char fim[16];
+            printf("ID inicial: "); fgets(id, sizeof(id), stdin); remover_quebra(id);
+            printf("ID final: "); fgets(fim, sizeof(fim), stdin); remover_quebra(fim);
+            buscar_intervalo_trie(trie, id, fim);
         }
 
 
     } while (opcao != 7);
 
+    radix_liberar(trie);
+    free(trie);
     return 0;
 }
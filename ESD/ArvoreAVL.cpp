@@ -4,6 +4,13 @@
 #include <stdbool.h>
 #include <math.h>
 #include <stdint.h>
+#include <stddef.h>
+#include "leitor_csv.h"
+#include "snapshot_fdb.h"
+#include "codec_id.h"
+#include "pool_indices.h"
+#include "cursor_arvore.h"
+#include "arvore_valores.h"
 
 // ================= ESTRUTURAS DE DADOS =================
 
@@ -20,11 +27,19 @@ typedef struct Transaction {
     bool is_fraud;
 } Transaction;
 
+// No da arvore so com o que a descida le: chave, filhos e altura, mais o
+// valor e a flag de fraude, usados pelo indice de valores. A Transaction
+// fica no deposito de registros e o no guarda o indice dela; filhos sao
+// indices no pool de nos (0 = nenhum). Sao 32 bytes por no, dois por linha
+// de cache, contra ~250 com a Transaction embutida.
 typedef struct AVLNode {
-    Transaction data;
-    struct AVLNode* left;
-    struct AVLNode* right;
+    uint64_t chave;     // transaction_id codificado (codec_id.h), comparado antes do texto
+    uint32_t registro;  // Indice da Transaction em registros_avl
+    uint32_t left;
+    uint32_t right;
+    float amount;
     uint8_t height;
+    bool is_fraud;
 } AVLNode;
 
 typedef struct Grupo {
@@ -34,199 +49,411 @@ typedef struct Grupo {
     struct Grupo* prox;
 } Grupo;
 
+// Indice secundario pelos valores das transacoes da arvore (arvore_valores.h),
+// mantido por insert_avl e delete_avl; alimenta as estatisticas e, pelas
+// listas de registros de cada valor, os filtros por valor
+NoValor* indice_valores = NULL;
+
+PoolIndices nos_avl;        // AVLNode; a raiz e so um indice aqui dentro
+PoolIndices registros_avl;  // Transaction de cada no
+
+// Encadeamento das listas de registros do indice de valores: o seguinte com
+// o mesmo valor, por indice de registro (0 = fim)
+uint32_t* proximo_valor = NULL;
+uint32_t capacidade_proximo = 0;
+
 // ================= FUNÇÕES AVL =================
 
 int max(int a, int b) { return (a > b) ? a : b; }
 
-int height(AVLNode* node) { return node ? node->height : 0; }
+// Ponteiros valem ate a proxima insercao (o pool pode crescer e mudar de lugar)
+AVLNode* no_avl(uint32_t node) { return (AVLNode*)pool_item(&nos_avl, node); }
 
-int get_balance(AVLNode* node) {
-    return node ? height(node->left) - height(node->right) : 0;
+Transaction* registro_no(const AVLNode* node) {
+    return (Transaction*)pool_item(&registros_avl, node->registro);
 }
 
-AVLNode* create_node(Transaction t) {
-    AVLNode* node = (AVLNode*)malloc(sizeof(AVLNode));
-    if (!node) return NULL;
-    node->data = t;
-    node->left = node->right = NULL;
-    node->height = 1;
+int height(uint32_t node) { return node ? no_avl(node)->height : 0; }
+
+int get_balance(uint32_t node) {
+    return node ? height(no_avl(node)->left) - height(no_avl(node)->right) : 0;
+}
+
+uint32_t create_node(const Transaction* t, uint64_t chave) {
+    uint32_t registro = pool_alocar(&registros_avl);
+    *(Transaction*)pool_item(&registros_avl, registro) = *t;
+    uint32_t node = pool_alocar(&nos_avl);
+    AVLNode* n = no_avl(node);
+    n->chave = chave;
+    n->registro = registro;
+    n->left = n->right = 0;
+    n->amount = t->amount;
+    n->height = 1;
+    n->is_fraud = t->is_fraud;
     return node;
 }
 
-AVLNode* right_rotate(AVLNode* y) {
-    AVLNode* x = y->left;
-    AVLNode* T2 = x->right;
-    x->right = y;
-    y->left = T2;
-    y->height = max(height(y->left), height(y->right)) + 1;
-    x->height = max(height(x->left), height(x->right)) + 1;
+uint32_t right_rotate(uint32_t y) {
+    AVLNode* ny = no_avl(y);
+    uint32_t x = ny->left;
+    AVLNode* nx = no_avl(x);
+    uint32_t T2 = nx->right;
+    nx->right = y;
+    ny->left = T2;
+    ny->height = max(height(ny->left), height(ny->right)) + 1;
+    nx->height = max(height(nx->left), height(nx->right)) + 1;
     return x;
 }
 
-AVLNode* left_rotate(AVLNode* x) {
-    AVLNode* y = x->right;
-    AVLNode* T2 = y->left;
-    y->left = x;
-    x->right = T2;
-    x->height = max(height(x->left), height(x->right)) + 1;
-    y->height = max(height(y->left), height(y->right)) + 1;
+uint32_t left_rotate(uint32_t x) {
+    AVLNode* nx = no_avl(x);
+    uint32_t y = nx->right;
+    AVLNode* ny = no_avl(y);
+    uint32_t T2 = ny->left;
+    ny->left = x;
+    nx->right = T2;
+    nx->height = max(height(nx->left), height(nx->right)) + 1;
+    ny->height = max(height(ny->left), height(ny->right)) + 1;
     return y;
 }
-//Inserção de transação
-AVLNode* insert_avl(AVLNode* node, Transaction t) {
-    if (!node) return create_node(t);
-    
-    int cmp = strcmp(t.transaction_id, node->data.transaction_id);
-    if (cmp < 0)
-        node->left = insert_avl(node->left, t);
-    else if (cmp > 0)
-        node->right = insert_avl(node->right, t);
-    else
-        return node;
 
-    node->height = 1 + max(height(node->left), height(node->right));
+// Corrige o balanceamento de "node" depois de uma insercao ou remocao abaixo dele
+uint32_t balancear(uint32_t node) {
+    AVLNode* n = no_avl(node);
+    n->height = 1 + max(height(n->left), height(n->right));
     int balance = get_balance(node);
 
-    if (balance > 1 && cmp < 0)
-        return right_rotate(node);
-    if (balance < -1 && cmp > 0)
-        return left_rotate(node);
-    if (balance > 1 && cmp > 0) {
-        node->left = left_rotate(node->left);
+    if (balance > 1) {
+        if (get_balance(n->left) < 0)
+            n->left = left_rotate(n->left);
         return right_rotate(node);
     }
-    if (balance < -1 && cmp < 0) {
-        node->right = right_rotate(node->right);
+    if (balance < -1) {
+        if (get_balance(n->right) > 0)
+            n->right = right_rotate(n->right);
         return left_rotate(node);
     }
     return node;
 }
-//Busca de transação por ID
-AVLNode* search_avl(AVLNode* root, const char* id) {
-    if (!root) return NULL;
-    int cmp = strcmp(id, root->data.transaction_id);
-    if (cmp == 0) return root;
-    return cmp < 0 ? search_avl(root->left, id) : search_avl(root->right, id);
+
+// O texto do ID so e lido em empate de chaves irregulares
+int comparar_no(uint64_t chave, const char* id, uint32_t node) {
+    const AVLNode* n = no_avl(node);
+    return codec_id_comparar(chave, id, n->chave, registro_no(n)->transaction_id);
+}
+
+// Em *novo fica o no criado (0 se o ID ja existia)
+uint32_t inserir_no(uint32_t node, const Transaction* t, uint64_t chave, uint32_t* novo) {
+    if (!node) {
+        *novo = create_node(t, chave);
+        return *novo;
+    }
+
+    int cmp = comparar_no(chave, t->transaction_id, node);
+    uint32_t filho;
+    // A insercao pode realocar o pool: o indice do filho so e gravado na volta
+    if (cmp < 0) {
+        filho = inserir_no(no_avl(node)->left, t, chave, novo);
+        no_avl(node)->left = filho;
+    } else if (cmp > 0) {
+        filho = inserir_no(no_avl(node)->right, t, chave, novo);
+        no_avl(node)->right = filho;
+    } else
+        return node;
+
+    return balancear(node);
+}
+
+// ================= ÍNDICE POR VALOR =================
+
+// Garante espaco no encadeamento para todo registro ja entregue pelo deposito
+void reservar_proximo_valor() {
+    if (capacidade_proximo >= registros_avl.capacidade) return;
+    uint32_t* novo = (uint32_t*)realloc(proximo_valor, (size_t)registros_avl.capacidade * sizeof(uint32_t));
+    if (!novo) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        exit(1);
+    }
+    proximo_valor = novo;
+    capacidade_proximo = registros_avl.capacidade;
+}
+
+// Conta a transacao no indice de valores e poe o registro na lista do valor.
+// Valores nao finitos nao tem lugar na ordem: nem chegam aqui (insert_avl e
+// converter_linha os recusam)
+void indexar_valor(uint32_t registro, float amount, bool is_fraud) {
+    indice_valores = valores_inserir(indice_valores, amount, is_fraud);
+    NoValor* v = valores_buscar(indice_valores, amount);
+    if (!v) return;
+    reservar_proximo_valor();
+    proximo_valor[registro] = v->registros;
+    v->registros = registro;
 }
 
-AVLNode* min_value_node(AVLNode* node) {
-    while (node->left) node = node->left;
+// Tira o registro da lista do valor (sao poucos por valor) e desconta a transacao
+void desindexar_valor(uint32_t registro, float amount, bool is_fraud) {
+    NoValor* v = valores_buscar(indice_valores, amount);
+    if (!v) return;
+    uint32_t* elo = &v->registros;
+    while (*elo && *elo != registro) elo = &proximo_valor[*elo];
+    if (*elo) *elo = proximo_valor[registro];
+    indice_valores = valores_remover(indice_valores, amount, is_fraud);
+}
+
+//Inserção de transação: o ID e codificado uma vez so, antes da descida.
+// Valor NaN ou infinito e recusado (a arvore fica como estava)
+uint32_t insert_avl(uint32_t node, Transaction t) {
+    if (!isfinite(t.amount)) return node;
+    uint32_t novo = 0;
+    node = inserir_no(node, &t, codec_id_codificar(t.transaction_id), &novo);
+    if (novo) indexar_valor(no_avl(novo)->registro, t.amount, t.is_fraud);
     return node;
 }
-//Remoção de transação por ID
-AVLNode* delete_avl(AVLNode* root, const char* id) {
-    if (!root) return NULL;
-    
-    int cmp = strcmp(id, root->data.transaction_id);
+//Busca de transação por ID: devolve o indice do no (0 se nao achar)
+uint32_t search_avl(uint32_t root, const char* id) {
+    uint64_t chave = codec_id_codificar(id);
+    while (root) {
+        int cmp = comparar_no(chave, id, root);
+        if (cmp == 0) return root;
+        root = cmp < 0 ? no_avl(root)->left : no_avl(root)->right;
+    }
+    return 0;
+}
+
+uint32_t min_value_node(uint32_t node) {
+    while (no_avl(node)->left) node = no_avl(node)->left;
+    return node;
+}
+uint32_t remover_no(uint32_t root, uint64_t chave, const char* id) {
+    if (!root) return 0;
+
+    AVLNode* n = no_avl(root);
+    int cmp = comparar_no(chave, id, root);
     if (cmp < 0)
-        root->left = delete_avl(root->left, id);
+        n->left = remover_no(n->left, chave, id);
     else if (cmp > 0)
-        root->right = delete_avl(root->right, id);
+        n->right = remover_no(n->right, chave, id);
     else {
-        if (!root->left || !root->right) {
-            AVLNode* temp = root->left ? root->left : root->right;
-            free(root);
+        if (!n->left || !n->right) {
+            uint32_t temp = n->left ? n->left : n->right;
+            pool_devolver(&registros_avl, n->registro);
+            pool_devolver(&nos_avl, root);
             return temp;
         }
-        AVLNode* temp = min_value_node(root->right);
-        root->data = temp->data;
-        root->right = delete_avl(root->right, temp->data.transaction_id);
+        // Troca os campos do no (nao a Transaction) com o sucessor, que passa
+        // a ter a chave removida. Ela e menor que toda a subarvore direita,
+        // entao a descida abaixo vai sempre a esquerda e para no sucessor
+        AVLNode* s = no_avl(min_value_node(n->right));
+        AVLNode copia = *n;
+        n->chave = s->chave;
+        n->registro = s->registro;
+        n->amount = s->amount;
+        n->is_fraud = s->is_fraud;
+        s->chave = copia.chave;
+        s->registro = copia.registro;
+        s->amount = copia.amount;
+        s->is_fraud = copia.is_fraud;
+        n->right = remover_no(n->right, chave, id);
     }
 
-    root->height = 1 + max(height(root->left), height(root->right));
-    int balance = get_balance(root);
+    return balancear(root);
+}
+
+//Remoção de transação por ID
+uint32_t delete_avl(uint32_t root, const char* id) {
+    uint32_t alvo = search_avl(root, id);
+    if (!alvo) return root;
+    const AVLNode* n = no_avl(alvo);
+    desindexar_valor(n->registro, n->amount, n->is_fraud);
+    return remover_no(root, codec_id_codificar(id), id);
+}
+
+// ================= PERCURSO E INTERVALOS =================
+
+// Percurso em ordem sem recursao (cursor_arvore.h): primeiro_no devolve o
+// menor no, proximo_no os seguintes, ate NULL
+AVLNode* primeiro_no(CursorArvore* it, uint32_t root) {
+    return (AVLNode*)cursor_primeiro(it, nos_avl.itens, sizeof(AVLNode), root,
+                                     offsetof(AVLNode, left), offsetof(AVLNode, right));
+}
+
+AVLNode* proximo_no(CursorArvore* it) {
+    return (AVLNode*)cursor_proximo(it);
+}
 
-    if (balance > 1 && get_balance(root->left) >= 0)
-        return right_rotate(root);
-    if (balance > 1 && get_balance(root->left) < 0) {
-        root->left = left_rotate(root->left);
-        return right_rotate(root);
+// Primeiro no com chave >= "chave" (NULL se nao houver). A descida so
+// empilha os nos onde vai para a esquerda: subarvores inteiras abaixo da
+// chave ficam de fora, e o cursor segue em ordem dali
+AVLNode* primeiro_desde(CursorArvore* it, uint32_t root, uint64_t chave) {
+    cursor_iniciar(it, nos_avl.itens, sizeof(AVLNode), offsetof(AVLNode, left), offsetof(AVLNode, right));
+    while (root) {
+        AVLNode* n = no_avl(root);
+        if (chave <= n->chave) {
+            cursor_empilhar(it, root);
+            root = n->left;
+        } else {
+            root = n->right;
+        }
     }
-    if (balance < -1 && get_balance(root->right) <= 0)
-        return left_rotate(root);
-    if (balance < -1 && get_balance(root->right) > 0) {
-        root->right = right_rotate(root->right);
-        return left_rotate(root);
+    return proximo_no(it);
+}
+
+// Chama "visitar" para cada no com chave em [lo, hi], em ordem, e devolve
+// quantos foram. Corta as subarvores fora da faixa dos dois lados: O(log n + k)
+int avl_range(uint32_t root, uint64_t lo, uint64_t hi, void (*visitar)(AVLNode* no, void* contexto), void* contexto) {
+    CursorArvore it;
+    int visitados = 0;
+    for (AVLNode* no = primeiro_desde(&it, root, lo); no && no->chave <= hi; no = proximo_no(&it)) {
+        visitar(no, contexto);
+        visitados++;
     }
-    return root;
+    return visitados;
 }
 
-// ================= FUNÇÕES DE ESTATÍSTICAS =================
+// ================= CONSTRUÇÃO EM LOTE =================
 
-void coletar_dados(AVLNode* root, float* valores, int* index, int* total_fraudes, 
-                  float* soma, float* maior, float* menor) {
-    if (!root) return;
-    
-    coletar_dados(root->left, valores, index, total_fraudes, soma, maior, menor);
-    
-    valores[*index] = root->data.amount;
-    (*index)++;
-    *soma += root->data.amount;
-    
-    if (root->data.amount > *maior) *maior = root->data.amount;
-    if (root->data.amount < *menor) *menor = root->data.amount;
-    if (root->data.is_fraud) (*total_fraudes)++;
-    
-    coletar_dados(root->right, valores, index, total_fraudes, soma, maior, menor);
+// Chave de uma transacao ja guardada no deposito, na ordem de leitura
+typedef struct EntradaCarga {
+    uint64_t chave;
+    uint32_t registro;
+} EntradaCarga;
+
+const char* id_entrada(const EntradaCarga* e) {
+    return ((Transaction*)pool_item(&registros_avl, e->registro))->transaction_id;
 }
 
-int contar_transacoes(AVLNode* root) {
-    if (!root) return 0;
-    return 1 + contar_transacoes(root->left) + contar_transacoes(root->right);
+// Ordem de ID; IDs repetidos ficam na ordem de leitura
+int comparar_entradas(const EntradaCarga* a, const EntradaCarga* b) {
+    int cmp = codec_id_comparar(a->chave, id_entrada(a), b->chave, id_entrada(b));
+    if (cmp != 0) return cmp;
+    return (a->registro > b->registro) - (a->registro < b->registro);
 }
 
-void calcular_estatisticas(AVLNode* root) {
-    int total = contar_transacoes(root);
-    if (total == 0) {
-        printf("Nenhuma transacao registrada.\n");
-        return;
+int comparar_entradas_qsort(const void* a, const void* b) {
+    return comparar_entradas((const EntradaCarga*)a, (const EntradaCarga*)b);
+}
+
+// So pela chave, para chaves que ja sao unicas (as de montar_valores)
+int comparar_chaves_qsort(const void* a, const void* b) {
+    uint64_t x = ((const EntradaCarga*)a)->chave;
+    uint64_t y = ((const EntradaCarga*)b)->chave;
+    return (x > y) - (x < y);
+}
+
+// Subarvore perfeitamente balanceada de e[inicio, fim): o meio vira a raiz.
+// Os nos saem em pre-ordem, entao cada pai fica perto dos filhos no pool
+uint32_t montar_avl(const EntradaCarga* e, size_t inicio, size_t fim) {
+    if (inicio >= fim) return 0;
+    size_t meio = inicio + (fim - inicio) / 2;
+    uint32_t node = pool_alocar(&nos_avl);
+    uint32_t left = montar_avl(e, inicio, meio);
+    uint32_t right = montar_avl(e, meio + 1, fim);
+
+    const Transaction* t = (const Transaction*)pool_item(&registros_avl, e[meio].registro);
+    AVLNode* n = no_avl(node);
+    n->chave = e[meio].chave;
+    n->registro = e[meio].registro;
+    n->left = left;
+    n->right = right;
+    n->amount = t->amount;
+    n->height = 1 + max(height(left), height(right));
+    n->is_fraud = t->is_fraud;
+    return node;
+}
+
+// Indice de valores das entradas (reaproveitadas: a chave vira o valor
+// codificado e o registro, e elas sao reordenadas). Cada sequencia de valores
+// iguais vira um no, com a lista dos seus registros em ordem crescente, e a
+// arvore sai montada pelo meio, sem uma insercao por transacao
+void montar_valores(EntradaCarga* e, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const Transaction* t = (const Transaction*)pool_item(&registros_avl, e[i].registro);
+        e[i].chave = ((uint64_t)codec_valor(t->amount) << 32) | e[i].registro;
     }
+    qsort(e, n, sizeof(EntradaCarga), comparar_chaves_qsort);
+    reservar_proximo_valor();
 
-    float* valores = (float*)malloc(total * sizeof(float));
-    if (!valores) {
-        printf("Erro ao alocar memoria.\n");
-        return;
+    NoValor** nos = (NoValor**)malloc((n ? n : 1) * sizeof(NoValor*));
+    if (!nos) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        exit(1);
+    }
+    size_t distintos = 0;
+    for (size_t fim = n; fim > 0;) {
+        // Sequencia e[inicio, fim) de valores iguais, lida de tras para frente
+        size_t inicio = fim - 1;
+        while (inicio > 0 && (e[inicio - 1].chave >> 32) == (e[fim - 1].chave >> 32)) inicio--;
+
+        NoValor* v = (NoValor*)malloc(sizeof(NoValor));
+        if (!v) {
+            fprintf(stderr, "Erro de alocacao de memoria.\n");
+            exit(1);
+        }
+        v->valor = ((const Transaction*)pool_item(&registros_avl, e[inicio].registro))->amount;
+        v->repeticoes = (int)(fim - inicio);
+        v->fraudes = 0;
+        v->registros = 0;
+        for (size_t i = fim; i-- > inicio;) {
+            uint32_t r = e[i].registro;
+            if (((const Transaction*)pool_item(&registros_avl, r))->is_fraud) v->fraudes++;
+            proximo_valor[r] = v->registros;
+            v->registros = r;
+        }
+        nos[distintos++] = v;
+        fim = inicio;
     }
 
-    int index = 0, total_fraudes = 0;
-    float soma = 0, maior = -INFINITY, menor = INFINITY;
-    
-    coletar_dados(root, valores, &index, &total_fraudes, &soma, &maior, &menor);
-    
-    // Ordenar para mediana e moda
-    qsort(valores, total, sizeof(float), 
-         [](const void* a, const void* b) {
-             float fa = *(const float*)a, fb = *(const float*)b;
-             return (fa > fb) - (fa < fb);
-         });
-
-    // Calcular mediana
-    float mediana = (total % 2 == 0) ? 
-                   (valores[total/2 - 1] + valores[total/2]) / 2 : 
-                   valores[total/2];
-
-    // Calcular moda
-    float moda = valores[0];
-    int count = 1, max_count = 1;
-    for (int i = 1; i < total; i++) {
-        if (valores[i] == valores[i-1]) {
-            count++;
-            if (count > max_count) {
-                max_count = count;
-                moda = valores[i];
-            }
-        } else {
-            count = 1;
+    // Os nos sairam do maior para o menor valor
+    for (size_t i = 0; i < distintos / 2; i++) {
+        NoValor* troca = nos[i];
+        nos[i] = nos[distintos - 1 - i];
+        nos[distintos - 1 - i] = troca;
+    }
+    valores_liberar(indice_valores);
+    indice_valores = valores_montar(nos, 0, distintos);
+    free(nos);
+}
+
+// Arvore inteira em O(n) a partir das transacoes ja no deposito: confere se
+// as chaves vieram em ordem (so ordena se nao vieram), descarta IDs
+// repetidos (fica o primeiro lido, como em insert_avl) e monta pelo meio.
+// Monta tambem o indice de valores, que sempre precisa ordenar
+uint32_t construir_avl(EntradaCarga* e, size_t n) {
+    bool ordenado = true;
+    for (size_t i = 1; i < n && ordenado; i++)
+        ordenado = comparar_entradas(&e[i - 1], &e[i]) < 0;
+    if (!ordenado) qsort(e, n, sizeof(EntradaCarga), comparar_entradas_qsort);
+
+    size_t unicos = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (unicos > 0 && codec_id_iguais(e[unicos - 1].chave, id_entrada(&e[unicos - 1]), e[i].chave, id_entrada(&e[i]))) {
+            pool_devolver(&registros_avl, e[i].registro);
+            continue;
         }
+        e[unicos++] = e[i];
     }
 
-    // Calcular média e desvio padrão
-    float media = soma / total;
-    float variancia = 0;
-    for (int i = 0; i < total; i++) {
-        variancia += pow(valores[i] - media, 2);
+    pool_reservar(&nos_avl, (uint32_t)unicos + 1);
+    uint32_t root = montar_avl(e, 0, unicos);
+    montar_valores(e, unicos);
+    return root;
+}
+
+// ================= FUNÇÕES DE ESTATÍSTICAS =================
+
+// Tudo sai dos agregados do indice de valores, sem percorrer a arvore
+void calcular_estatisticas(const NoValor* valores) {
+    int total = valores_tamanho(valores);
+    if (total == 0) {
+        printf("Nenhuma transacao registrada.\n");
+        return;
     }
-    float desvio = sqrt(variancia / total);
+
+    double soma = valores_soma(valores);
+    double media = soma / total;
+    double variancia = valores_soma_quadrados(valores) / total - media * media;
+    float desvio = sqrt(variancia > 0 ? variancia : 0);
+    int total_fraudes = valores_fraudes(valores);
     float porcentagem_fraudes = (total_fraudes * 100.0f) / total;
 
     printf("\n=== Estatisticas ===\n");
@@ -235,12 +462,10 @@ void calcular_estatisticas(AVLNode* root) {
     printf("Valor total movimentado: %.2f\n", soma);
     printf("Media dos valores: %.2f\n", media);
     printf("Desvio padrao: %.2f\n", desvio);
-    printf("Maior valor: %.2f\n", maior);
-    printf("Menor valor: %.2f\n", menor);
-    printf("Mediana: %.2f\n", mediana);
-    printf("Moda: %.2f (%d ocorrencias)\n", moda, max_count);
-
-    free(valores);
+    printf("Maior valor: %.2f\n", valores_maximo(valores));
+    printf("Menor valor: %.2f\n", valores_minimo(valores));
+    printf("Mediana: %.2f\n", valores_mediana(valores));
+    printf("Moda: %.2f (%d ocorrencias)\n", valores->moda, valores->moda_repeticoes);
 }
 
 // ================= FUNÇÕES DE AGRUPAMENTO =================
@@ -269,25 +494,23 @@ void inserir_grupo(Grupo** lista, const char* chave, float valor) {
     *lista = novo;
 }
 
-void agrupar_transacoes(AVLNode* root, Grupo** grupos, int campo) {
-    if (!root) return;
-    
-    agrupar_transacoes(root->left, grupos, campo);
-    
-    const char* chave = "";
-    switch (campo) {
-        case 1: chave = root->data.transaction_type; break;
-        case 2: chave = root->data.merchant_category; break;
-        case 3: chave = root->data.location; break;
-        case 4: chave = root->data.device_used; break;
-        case 5: chave = root->data.sender_account; break;
-        case 6: chave = root->data.receiver_account; break;
-        default: chave = "Indefinido";
+void agrupar_transacoes(uint32_t root, Grupo** grupos, int campo) {
+    CursorArvore it;
+    for (AVLNode* no = primeiro_no(&it, root); no; no = proximo_no(&it)) {
+        const Transaction* t = registro_no(no);
+        const char* chave = "";
+        switch (campo) {
+            case 1: chave = t->transaction_type; break;
+            case 2: chave = t->merchant_category; break;
+            case 3: chave = t->location; break;
+            case 4: chave = t->device_used; break;
+            case 5: chave = t->sender_account; break;
+            case 6: chave = t->receiver_account; break;
+            default: chave = "Indefinido";
+        }
+
+        inserir_grupo(grupos, chave, no->amount);
     }
-    
-    inserir_grupo(grupos, chave, root->data.amount);
-    
-    agrupar_transacoes(root->right, grupos, campo);
 }
 
 void imprimir_grupos(Grupo* grupos, const char* titulo) {
@@ -315,34 +538,63 @@ void liberar_grupos(Grupo* grupos) {
 
 // ================= FUNÇÕES DE CARREGAMENTO =================
 
-AVLNode* load_csv(const char* filename) {
-    AVLNode* root = NULL;
-    FILE* file = fopen(filename, "r");
-    if (!file) {
+//Conversao de uma linha do CSV para Transaction
+bool converter_linha(const LinhaCSV* linha, void* destino) {
+    Transaction* t = (Transaction*)destino;
+    if (!csv_linha_completa(linha)) return false;
+    CSV_COPIAR(t->transaction_id, linha->campos[CAMPO_ID]);
+    CSV_COPIAR(t->timestamp, linha->campos[CAMPO_TIMESTAMP]);
+    CSV_COPIAR(t->sender_account, linha->campos[CAMPO_SENDER]);
+    CSV_COPIAR(t->receiver_account, linha->campos[CAMPO_RECEIVER]);
+    t->amount = csv_linha_amount(linha);
+    if (!isfinite(t->amount)) return false;
+    CSV_COPIAR(t->transaction_type, linha->campos[CAMPO_TIPO]);
+    CSV_COPIAR(t->merchant_category, linha->campos[CAMPO_CATEGORIA]);
+    CSV_COPIAR(t->location, linha->campos[CAMPO_LOCAL]);
+    CSV_COPIAR(t->device_used, linha->campos[CAMPO_DISPOSITIVO]);
+    t->is_fraud = csv_campo_fraude(linha->campos[CAMPO_FRAUDE]);
+    return true;
+}
+
+typedef struct CargaAVL {
+    EntradaCarga* entradas;
+    size_t quantidade;
+    size_t capacidade;
+} CargaAVL;
+
+// Na carga so guarda a transacao e anota a chave; a arvore sai de uma vez no fim
+void inserir_registro(void* registro, void* contexto) {
+    CargaAVL* carga = (CargaAVL*)contexto;
+    const Transaction* t = (const Transaction*)registro;
+    if (carga->quantidade == carga->capacidade) {
+        size_t capacidade = carga->capacidade ? carga->capacidade * 2 : 1024;
+        EntradaCarga* entradas = (EntradaCarga*)realloc(carga->entradas, capacidade * sizeof(EntradaCarga));
+        if (!entradas) {
+            fprintf(stderr, "Erro de alocacao de memoria.\n");
+            exit(1);
+        }
+        carga->entradas = entradas;
+        carga->capacidade = capacidade;
+    }
+    uint32_t i = pool_alocar(&registros_avl);
+    *(Transaction*)pool_item(&registros_avl, i) = *t;
+    carga->entradas[carga->quantidade].chave = codec_id_codificar(t->transaction_id);
+    carga->entradas[carga->quantidade++].registro = i;
+}
+
+uint32_t load_csv(const char* filename) {
+    pool_iniciar(&nos_avl, sizeof(AVLNode));
+    pool_iniciar(&registros_avl, sizeof(Transaction));
+    size_t estimativa = fdb_estimar_linhas(filename);
+    if (estimativa < UINT32_MAX / 2) pool_reservar(&registros_avl, (uint32_t)estimativa + 1);
+
+    CargaAVL carga = {NULL, 0, 0};
+    if (!fdb_carregar_ou_gerar(filename, sizeof(Transaction), converter_linha, inserir_registro, &carga, CSV_THREADS_AUTO)) {
         perror("Erro ao abrir o arquivo");
         exit(1);
     }
-    
-    char line[512];
-    fgets(line, sizeof(line), file); // Ignorar cabeçalho
-    
-    while (fgets(line, sizeof(line), file)) {
-        Transaction t;
-        char is_fraud_str[6];
-        
-        int campos_lidos = sscanf(line, "%15[^,],%31[^,],%31[^,],%31[^,],%f,%15[^,],%31[^,],%31[^,],%15[^,],%5[^,\n]",
-               t.transaction_id, t.timestamp, t.sender_account, t.receiver_account, &t.amount,
-               t.transaction_type, t.merchant_category, t.location, t.device_used, is_fraud_str);
-        
-        if (campos_lidos == 10) {
-            t.is_fraud = strcmp(is_fraud_str, "True") == 0;
-            root = insert_avl(root, t);
-        } else {
-            fprintf(stderr, "Linha ignorada por formato inválido: %s", line);
-        }
-    }
-    
-    fclose(file);
+    uint32_t root = construir_avl(carga.entradas, carga.quantidade);
+    free(carga.entradas);
     return root;
 }
 
@@ -368,6 +620,8 @@ void exibir_menu() {
     printf("5. Agrupar por campo\n");
     printf("6. Filtrar transacoes\n");
     printf("7. Sair\n");
+    printf("8. Percentil e posicao de um valor\n");
+    printf("9. Listar intervalo de IDs\n");
     printf("Escolha uma opcao: ");
 }
 
@@ -391,6 +645,7 @@ void exibir_campos_filtragem() {
     printf("5. Dispositivo Usado\n");
     printf("6. Conta do Remetente\n");
     printf("7. Conta do Destinatario\n");
+    printf("8. Faixa de Valor (minimo e maximo)\n");
     printf("Escolha o campo: ");
 }
 
@@ -405,41 +660,85 @@ void exibir_transacao(Transaction* t) {
     printf("Previsao de Fraude: %s\n", prever_fraude(t) ? "Sim" : "Nao");
 }
 
-void filtrar_transacoes_avl(AVLNode* root, int campo, const char* criterio_str, float criterio_valor, bool is_numerico) {
-    if (!root) return;
+void exibir_no(AVLNode* no, void* contexto) {
+    (void)contexto;
+    exibir_transacao(registro_no(no));
+}
+
+void exibir_registros_valor(NoValor* v, void* contexto) {
+    for (uint32_t r = v->registros; r; r = proximo_valor[r]) {
+        exibir_transacao((Transaction*)pool_item(&registros_avl, r));
+        (*(int*)contexto)++;
+    }
+}
 
-    filtrar_transacoes_avl(root->left, campo, criterio_str, criterio_valor, is_numerico);
+// Valores em [min_valor, max_valor] pelo indice de valores, do menor para o
+// maior: so desce ate a faixa e so visita o que esta nela
+void filtrar_por_valor(float min_valor, float max_valor) {
+    int encontradas = 0;
+    valores_visitar_faixa(indice_valores, min_valor, max_valor, exibir_registros_valor, &encontradas);
+    printf("%d transacoes na faixa.\n", encontradas);
+}
 
-    bool exibir = false;
-    if (is_numerico) {
-        if (campo == 1 && root->data.amount >= criterio_valor)
-            exibir = true;
-    } else {
+// Campos de texto nao tem indice: percorre a arvore de IDs inteira
+void filtrar_transacoes_avl(uint32_t root, int campo, const char* criterio_str) {
+    CursorArvore it;
+    for (AVLNode* no = primeiro_no(&it, root); no; no = proximo_no(&it)) {
+        const Transaction* t = registro_no(no);
         const char* valor = "";
         switch (campo) {
-            case 2: valor = root->data.transaction_type; break;
-            case 3: valor = root->data.merchant_category; break;
-            case 4: valor = root->data.location; break;
-            case 5: valor = root->data.device_used; break;
-            case 6: valor = root->data.sender_account; break;
-            case 7: valor = root->data.receiver_account; break;
+            case 2: valor = t->transaction_type; break;
+            case 3: valor = t->merchant_category; break;
+            case 4: valor = t->location; break;
+            case 5: valor = t->device_used; break;
+            case 6: valor = t->sender_account; break;
+            case 7: valor = t->receiver_account; break;
             default: valor = ""; break;
         }
         if (strcmp(valor, criterio_str) == 0)
-            exibir = true;
+            exibir_transacao(registro_no(no));
     }
+}
 
-    if (exibir) {
-        exibir_transacao(&(root->data));
+// Transacoes com ID entre "inicio" e "fim", na ordem das chaves (numerica
+// dentro de cada prefixo e quantidade de digitos, codec_id.h). IDs fora do
+// formato regular nao tem ordem util: a chave deles e um hash
+void listar_intervalo_ids(uint32_t root, const char* inicio, const char* fim) {
+    uint64_t de = codec_id_codificar(inicio);
+    uint64_t ate = codec_id_codificar(fim);
+    if (!codec_id_regular(de) || !codec_id_regular(ate)) {
+        printf("Intervalo so vale para IDs no formato T ou TRN seguido de digitos.\n");
+        return;
     }
+    int encontradas = avl_range(root, de, ate, exibir_no, NULL);
+    printf("%d transacoes no intervalo.\n", encontradas);
+}
 
-    filtrar_transacoes_avl(root->right, campo, criterio_str, criterio_valor, is_numerico);
+// Percentil e posto de um valor, pelo indice de valores
+void consultar_percentil(const NoValor* valores) {
+    int total = valores_tamanho(valores);
+    if (total == 0) {
+        printf("Nenhuma transacao registrada.\n");
+        return;
+    }
+
+    float p, valor;
+    printf("Digite o percentil (0 a 100): ");
+    scanf("%f", &p);
+    limpar_buffer();
+    printf("Percentil %.1f: %.2f\n", p, valores_percentil(valores, p));
+
+    printf("Digite um valor para ver sua posicao: ");
+    scanf("%f", &valor);
+    limpar_buffer();
+    int menores = valores_posto(valores, valor);
+    printf("%d de %d transacoes (%.2f%%) tem valor menor que %.2f\n", menores, total, (menores * 100.0f) / total, valor);
 }
 
 // ================= PROGRAMA PRINCIPAL =================
 
 int main() {
-    AVLNode* root = load_csv("C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv");
+    uint32_t root = load_csv("C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv");
     int opcao;
     char id[16];
 
@@ -454,9 +753,9 @@ int main() {
                 fgets(id, sizeof(id), stdin);
                 id[strcspn(id, "\n")] = '\0';
                 
-                AVLNode* node = search_avl(root, id);
+                uint32_t node = search_avl(root, id);
                 if (node) {
-                    exibir_transacao(&node->data);
+                    exibir_transacao(registro_no(no_avl(node)));
                 } else {
                     printf("Transacao nao encontrada.\n");
                 }
@@ -511,13 +810,17 @@ int main() {
                 is_fraud_str[strcspn(is_fraud_str, "\n")] = '\0';
                 
                 t.is_fraud = strcmp(is_fraud_str, "True") == 0;
+                if (!isfinite(t.amount)) {
+                    printf("Valor invalido: a transacao nao foi inserida.\n");
+                    break;
+                }
                 root = insert_avl(root, t);
                 printf("Transacao inserida com sucesso!\n");
                 break;
             }
                 
             case 4:
-                calcular_estatisticas(root);
+                calcular_estatisticas(indice_valores);
                 break;
                 
             case 5: {
@@ -552,13 +855,21 @@ int main() {
               printf("Digite o valor minimo da transacao: ");
               scanf("%f", &min_valor);
               limpar_buffer();
-              filtrar_transacoes_avl(root, campo, "", min_valor, true);
+              filtrar_por_valor(min_valor, INFINITY);
+              } else if (campo == 8) {
+              float min_valor, max_valor;
+              printf("Digite o valor minimo da transacao: ");
+              scanf("%f", &min_valor);
+              printf("Digite o valor maximo da transacao: ");
+              scanf("%f", &max_valor);
+              limpar_buffer();
+              filtrar_por_valor(min_valor, max_valor);
               } else if (campo >= 2 && campo <= 7) {
               char criterio[64];
               printf("Digite o valor do campo para filtrar: ");
               fgets(criterio, sizeof(criterio), stdin);
               criterio[strcspn(criterio, "\n")] = '\0'; 
-              filtrar_transacoes_avl(root, campo, criterio, 0, false);
+              filtrar_transacoes_avl(root, campo, criterio);
               } else {
               printf("Campo invalido.\n");
               }
@@ -568,14 +879,32 @@ int main() {
             case 7:
                 printf("Encerrando o programa...\n");
                 break;
+
+            case 8:
+                consultar_percentil(indice_valores);
+                break;
+
+            case 9: {
+                char fim[16];
+                printf("Digite o ID inicial: ");
+                fgets(id, sizeof(id), stdin);
+                id[strcspn(id, "\n")] = '\0';
+                printf("Digite o ID final: ");
+                fgets(fim, sizeof(fim), stdin);
+                fim[strcspn(fim, "\n")] = '\0';
+                listar_intervalo_ids(root, id, fim);
+                break;
+            }
                 
             default:
                 printf("Opcao invalida! Tente novamente.\n");
         }
     } while (opcao != 7);
 
-    // Liberar memória da árvore
-    // (Implementação de liberação de memória da árvore seria necessária aqui)
-    
+    valores_liberar(indice_valores);
+    free(proximo_valor);
+    pool_liberar(&nos_avl);
+    pool_liberar(&registros_avl);
+
     return 0;
 }
\ No newline at end of file
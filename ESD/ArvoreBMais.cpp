@@ -0,0 +1,605 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <stdint.h>
+#include "leitor_csv.h"
+#include "snapshot_fdb.h"
+#include "codec_id.h"
+#include "pool_indices.h"
+#include "arvore_bmais.h"
+#include "arvore_valores.h"
+
+// Bytes por no das arvores B+: 16 linhas de cache, 62 pares por no. Na
+// comparacao do Benchmark_AVL foi o melhor equilibrio entre busca e intervalos
+#define BYTES_NO 1024
+
+// ================= ESTRUTURAS DE DADOS =================
+
+typedef struct Transaction {
+    char transaction_id[16];
+    char timestamp[32];
+    char sender_account[32];
+    char receiver_account[32];
+    float amount;
+    char transaction_type[16];
+    char merchant_category[32];
+    char location[32];
+    char device_used[16];
+    bool is_fraud;
+} Transaction;
+
+typedef struct Grupo {
+    char chave[64];
+    int quantidade;
+    float soma_valores;
+    struct Grupo* prox;
+} Grupo;
+
+// As transacoes ficam no deposito de registros e as duas arvores B+ guardam
+// pares (chave, indice do registro): uma pelo ID codificado (codec_id.h),
+// outra pelo valor. IDs irregulares com o mesmo hash e valores repetidos
+// viram pares distintos, entao nenhuma das duas precisa tratar colisao
+PoolIndices registros;       // Transaction; o indice 0 nunca e usado
+ArvoreBMais indice_ids;
+ArvoreBMais indice_amounts;
+
+// Indice de estatistica de ordem pelos valores (arvore_valores.h), mantido
+// junto com as arvores; alimenta as estatisticas e os percentis
+NoValor* indice_valores = NULL;
+
+// ================= FUNÇÕES B+ =================
+
+Transaction* registro(uint32_t i) { return (Transaction*)pool_item(&registros, i); }
+
+//Busca de transação por ID: devolve o indice do registro (0 se nao achar).
+//So chaves irregulares podem se repetir; o texto desempata
+uint32_t search_bmais(const char* id) {
+    uint64_t chave = codec_id_codificar(id);
+    CursorBMais c;
+    uint64_t achada;
+    uint32_t r;
+    bmais_cursor_desde(&c, &indice_ids, chave, 0);
+    while (bmais_proximo(&c, &achada, &r) && achada == chave) {
+        if (codec_id_regular(chave) || strcmp(registro(r)->transaction_id, id) == 0)
+            return r;
+    }
+    return 0;
+}
+
+//Inserção de transação: ignorada se o ID ja existe
+bool insert_bmais(const Transaction* t) {
+    if (search_bmais(t->transaction_id)) return false;
+    uint32_t r = pool_alocar(&registros);
+    *registro(r) = *t;
+    bmais_inserir(&indice_ids, codec_id_codificar(t->transaction_id), r);
+    bmais_inserir(&indice_amounts, codec_valor(t->amount), r);
+    indice_valores = valores_inserir(indice_valores, t->amount, t->is_fraud);
+    return true;
+}
+
+//Remoção de transação por ID
+bool delete_bmais(const char* id) {
+    uint32_t r = search_bmais(id);
+    if (!r) return false;
+    const Transaction* t = registro(r);
+    bmais_remover(&indice_ids, codec_id_codificar(id), r);
+    bmais_remover(&indice_amounts, codec_valor(t->amount), r);
+    indice_valores = valores_remover(indice_valores, t->amount, t->is_fraud);
+    pool_devolver(&registros, r);
+    return true;
+}
+
+// ================= CONSTRUÇÃO EM LOTE =================
+
+int comparar_pares(const void* a, const void* b) {
+    const ParBMais* x = (const ParBMais*)a;
+    const ParBMais* y = (const ParBMais*)b;
+    if (x->chave != y->chave) return x->chave < y->chave ? -1 : 1;
+    return (x->valor > y->valor) - (x->valor < y->valor);
+}
+
+void ordenar_pares(ParBMais* pares, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        if (comparar_pares(&pares[i - 1], &pares[i]) > 0) {
+            qsort(pares, n, sizeof(ParBMais), comparar_pares);
+            return;
+        }
+    }
+}
+
+// Monta as duas arvores de uma vez a partir dos pares (ID, registro) na
+// ordem de leitura: ordena (se preciso), descarta IDs repetidos (fica o
+// primeiro lido, como em insert_bmais) e reaproveita o vetor para os valores
+void construir_indices(ParBMais* pares, size_t n) {
+    ordenar_pares(pares, n);
+
+    size_t unicos = 0;
+    for (size_t i = 0; i < n; i++) {
+        bool repetido = false;
+        for (size_t j = unicos; j > 0 && pares[j - 1].chave == pares[i].chave && !repetido; j--)
+            repetido = codec_id_regular(pares[i].chave) ||
+                       strcmp(registro(pares[j - 1].valor)->transaction_id, registro(pares[i].valor)->transaction_id) == 0;
+        if (repetido) {
+            pool_devolver(&registros, pares[i].valor);
+            continue;
+        }
+        pares[unicos++] = pares[i];
+    }
+    bmais_construir(&indice_ids, pares, unicos);
+
+    for (size_t i = 0; i < unicos; i++) {
+        const Transaction* t = registro(pares[i].valor);
+        indice_valores = valores_inserir(indice_valores, t->amount, t->is_fraud);
+        pares[i].chave = codec_valor(t->amount);
+    }
+    ordenar_pares(pares, unicos);
+    bmais_construir(&indice_amounts, pares, unicos);
+}
+
+// ================= FUNÇÕES DE ESTATÍSTICAS =================
+
+// Tudo sai dos agregados do indice de valores, sem percorrer a arvore
+void calcular_estatisticas(const NoValor* valores) {
+    int total = valores_tamanho(valores);
+    if (total == 0) {
+        printf("Nenhuma transacao registrada.\n");
+        return;
+    }
+
+    double soma = valores_soma(valores);
+    double media = soma / total;
+    double variancia = valores_soma_quadrados(valores) / total - media * media;
+    float desvio = sqrt(variancia > 0 ? variancia : 0);
+    int total_fraudes = valores_fraudes(valores);
+    float porcentagem_fraudes = (total_fraudes * 100.0f) / total;
+
+    printf("\n=== Estatisticas ===\n");
+    printf("Total de transacoes: %d\n", total);
+    printf("Total de fraudes: %d (%.2f%%)\n", total_fraudes, porcentagem_fraudes);
+    printf("Valor total movimentado: %.2f\n", soma);
+    printf("Media dos valores: %.2f\n", media);
+    printf("Desvio padrao: %.2f\n", desvio);
+    printf("Maior valor: %.2f\n", valores_maximo(valores));
+    printf("Menor valor: %.2f\n", valores_minimo(valores));
+    printf("Mediana: %.2f\n", valores_mediana(valores));
+    printf("Moda: %.2f (%d ocorrencias)\n", valores->moda, valores->moda_repeticoes);
+}
+
+// ================= FUNÇÕES DE AGRUPAMENTO =================
+
+void inserir_grupo(Grupo** lista, const char* chave, float valor) {
+    Grupo* atual = *lista;
+    while (atual) {
+        if (strcmp(atual->chave, chave) == 0) {
+            atual->quantidade++;
+            atual->soma_valores += valor;
+            return;
+        }
+        atual = atual->prox;
+    }
+
+    Grupo* novo = (Grupo*)malloc(sizeof(Grupo));
+    if (!novo) {
+        printf("Erro ao alocar memoria para grupo.\n");
+        return;
+    }
+
+    strcpy(novo->chave, chave);
+    novo->quantidade = 1;
+    novo->soma_valores = valor;
+    novo->prox = *lista;
+    *lista = novo;
+}
+
+// Le a arvore de IDs em ordem, folha a folha
+void agrupar_transacoes(Grupo** grupos, int campo) {
+    CursorBMais c;
+    uint64_t chave;
+    uint32_t r;
+    bmais_primeiro(&c, &indice_ids);
+    while (bmais_proximo(&c, &chave, &r)) {
+        const Transaction* t = registro(r);
+        const char* campo_chave = "";
+        switch (campo) {
+            case 1: campo_chave = t->transaction_type; break;
+            case 2: campo_chave = t->merchant_category; break;
+            case 3: campo_chave = t->location; break;
+            case 4: campo_chave = t->device_used; break;
+            case 5: campo_chave = t->sender_account; break;
+            case 6: campo_chave = t->receiver_account; break;
+            default: campo_chave = "Indefinido";
+        }
+
+        inserir_grupo(grupos, campo_chave, t->amount);
+    }
+}
+
+void imprimir_grupos(Grupo* grupos, const char* titulo) {
+    printf("\n=== Agrupamento por %s ===\n", titulo);
+    printf("%-30s | %-8s | %-12s | %-10s\n", "Campo", "Qtd", "Total", "Media");
+    printf("------------------------------------------------------------\n");
+
+    while (grupos) {
+        printf("%-30s | %-8d | %-12.2f | %-10.2f\n",
+               grupos->chave,
+               grupos->quantidade,
+               grupos->soma_valores,
+               grupos->soma_valores / grupos->quantidade);
+        grupos = grupos->prox;
+    }
+}
+
+void liberar_grupos(Grupo* grupos) {
+    while (grupos) {
+        Grupo* temp = grupos;
+        grupos = grupos->prox;
+        free(temp);
+    }
+}
+
+// ================= FUNÇÕES DE CARREGAMENTO =================
+
+//Conversao de uma linha do CSV para Transaction
+bool converter_linha(const LinhaCSV* linha, void* destino) {
+    Transaction* t = (Transaction*)destino;
+    if (!csv_linha_completa(linha)) return false;
+    CSV_COPIAR(t->transaction_id, linha->campos[CAMPO_ID]);
+    CSV_COPIAR(t->timestamp, linha->campos[CAMPO_TIMESTAMP]);
+    CSV_COPIAR(t->sender_account, linha->campos[CAMPO_SENDER]);
+    CSV_COPIAR(t->receiver_account, linha->campos[CAMPO_RECEIVER]);
+    t->amount = csv_linha_amount(linha);
+    CSV_COPIAR(t->transaction_type, linha->campos[CAMPO_TIPO]);
+    CSV_COPIAR(t->merchant_category, linha->campos[CAMPO_CATEGORIA]);
+    CSV_COPIAR(t->location, linha->campos[CAMPO_LOCAL]);
+    CSV_COPIAR(t->device_used, linha->campos[CAMPO_DISPOSITIVO]);
+    t->is_fraud = csv_campo_fraude(linha->campos[CAMPO_FRAUDE]);
+    return true;
+}
+
+typedef struct CargaBMais {
+    ParBMais* pares;
+    size_t quantidade;
+    size_t capacidade;
+} CargaBMais;
+
+// Na carga so guarda a transacao e anota o par; as arvores saem de uma vez no fim
+void inserir_registro(void* dados, void* contexto) {
+    CargaBMais* carga = (CargaBMais*)contexto;
+    const Transaction* t = (const Transaction*)dados;
+    if (carga->quantidade == carga->capacidade) {
+        size_t capacidade = carga->capacidade ? carga->capacidade * 2 : 1024;
+        ParBMais* pares = (ParBMais*)realloc(carga->pares, capacidade * sizeof(ParBMais));
+        if (!pares) {
+            fprintf(stderr, "Erro de alocacao de memoria.\n");
+            exit(1);
+        }
+        carga->pares = pares;
+        carga->capacidade = capacidade;
+    }
+    uint32_t r = pool_alocar(&registros);
+    *registro(r) = *t;
+    carga->pares[carga->quantidade].chave = codec_id_codificar(t->transaction_id);
+    carga->pares[carga->quantidade++].valor = r;
+}
+
+void load_csv(const char* filename) {
+    pool_iniciar(&registros, sizeof(Transaction));
+    bmais_iniciar(&indice_ids, BYTES_NO);
+    bmais_iniciar(&indice_amounts, BYTES_NO);
+    size_t estimativa = fdb_estimar_linhas(filename);
+    if (estimativa < UINT32_MAX / 2) pool_reservar(&registros, (uint32_t)estimativa + 1);
+
+    CargaBMais carga = {NULL, 0, 0};
+    if (!fdb_carregar_ou_gerar(filename, sizeof(Transaction), converter_linha, inserir_registro, &carga, CSV_THREADS_AUTO)) {
+        perror("Erro ao abrir o arquivo");
+        exit(1);
+    }
+    construir_indices(carga.pares, carga.quantidade);
+    free(carga.pares);
+}
+
+// ================= FUNÇÕES AUXILIARES =================
+
+bool prever_fraude(Transaction* t) {
+    return (t->amount > 10000 || strcmp(t->device_used, "unknown") == 0);
+}
+
+void limpar_buffer() {
+    int c;
+    while ((c = getchar()) != '\n' && c != EOF);
+}
+
+// ================= MENU PRINCIPAL =================
+
+void exibir_menu() {
+    printf("\n=== MENU ARVORE B+ ===\n");
+    printf("1. Buscar transacao\n");
+    printf("2. Remover transacao\n");
+    printf("3. Inserir nova transacao\n");
+    printf("4. Mostrar estatisticas\n");
+    printf("5. Agrupar por campo\n");
+    printf("6. Filtrar transacoes\n");
+    printf("7. Sair\n");
+    printf("8. Percentil e posicao de um valor\n");
+    printf("9. Listar intervalo de IDs\n");
+    printf("Escolha uma opcao: ");
+}
+
+void exibir_campos_agrupamento() {
+    printf("\nAgrupar por:\n");
+    printf("1. Tipo de Transacao\n");
+    printf("2. Categoria do Comerciante\n");
+    printf("3. Localizacao\n");
+    printf("4. Dispositivo Usado\n");
+    printf("5. Conta do Remetente\n");
+    printf("6. Conta do Destinatario\n");
+    printf("Escolha o campo: ");
+}
+
+void exibir_campos_filtragem() {
+    printf("\nFiltrar por:\n");
+    printf("1. Valor Minimo da Transacao\n");
+    printf("2. Tipo de Transacao\n");
+    printf("3. Categoria do Comerciante\n");
+    printf("4. Localizacao\n");
+    printf("5. Dispositivo Usado\n");
+    printf("6. Conta do Remetente\n");
+    printf("7. Conta do Destinatario\n");
+    printf("Escolha o campo: ");
+}
+
+void exibir_transacao(Transaction* t) {
+    printf("\nTransacao encontrada:\n");
+    printf("ID: %s\n", t->transaction_id);
+    printf("Timestamp: %s\n", t->timestamp);
+    printf("De: %s | Para: %s\n", t->sender_account, t->receiver_account);
+    printf("Valor: %.2f | Fraude: %s\n", t->amount, t->is_fraud ? "Sim" : "Nao");
+    printf("Tipo: %s | Categoria: %s\n", t->transaction_type, t->merchant_category);
+    printf("Local: %s | Dispositivo: %s\n", t->location, t->device_used);
+    printf("Previsao de Fraude: %s\n", prever_fraude(t) ? "Sim" : "Nao");
+}
+
+// Valor minimo: desce ate o primeiro valor >= minimo na arvore de valores e
+// le as folhas dali em diante, do menor para o maior valor, sem olhar as
+// transacoes abaixo do minimo
+void filtrar_por_valor(float min_valor) {
+    CursorBMais c;
+    uint64_t chave;
+    uint32_t r;
+    bmais_cursor_desde(&c, &indice_amounts, codec_valor(min_valor), 0);
+    while (bmais_proximo(&c, &chave, &r))
+        exibir_transacao(registro(r));
+}
+
+void filtrar_transacoes(int campo, const char* criterio_str) {
+    CursorBMais c;
+    uint64_t chave;
+    uint32_t r;
+    bmais_primeiro(&c, &indice_ids);
+    while (bmais_proximo(&c, &chave, &r)) {
+        Transaction* t = registro(r);
+        const char* valor = "";
+        switch (campo) {
+            case 2: valor = t->transaction_type; break;
+            case 3: valor = t->merchant_category; break;
+            case 4: valor = t->location; break;
+            case 5: valor = t->device_used; break;
+            case 6: valor = t->sender_account; break;
+            case 7: valor = t->receiver_account; break;
+            default: valor = ""; break;
+        }
+        if (strcmp(valor, criterio_str) == 0)
+            exibir_transacao(t);
+    }
+}
+
+// Transacoes com ID entre "inicio" e "fim", na ordem das chaves (numerica
+// dentro de cada prefixo e quantidade de digitos, codec_id.h). IDs fora do
+// formato regular nao tem ordem util: a chave deles e um hash
+void listar_intervalo_ids(const char* inicio, const char* fim) {
+    uint64_t de = codec_id_codificar(inicio);
+    uint64_t ate = codec_id_codificar(fim);
+    if (!codec_id_regular(de) || !codec_id_regular(ate)) {
+        printf("Intervalo so vale para IDs no formato T ou TRN seguido de digitos.\n");
+        return;
+    }
+
+    CursorBMais c;
+    uint64_t chave;
+    uint32_t r;
+    int encontradas = 0;
+    bmais_cursor_desde(&c, &indice_ids, de, 0);
+    while (bmais_proximo(&c, &chave, &r) && chave <= ate) {
+        exibir_transacao(registro(r));
+        encontradas++;
+    }
+    printf("%d transacoes no intervalo.\n", encontradas);
+}
+
+// Percentil e posto de um valor, pelo indice de valores
+void consultar_percentil(const NoValor* valores) {
+    int total = valores_tamanho(valores);
+    if (total == 0) {
+        printf("Nenhuma transacao registrada.\n");
+        return;
+    }
+
+    float p, valor;
+    printf("Digite o percentil (0 a 100): ");
+    scanf("%f", &p);
+    limpar_buffer();
+    printf("Percentil %.1f: %.2f\n", p, valores_percentil(valores, p));
+
+    printf("Digite um valor para ver sua posicao: ");
+    scanf("%f", &valor);
+    limpar_buffer();
+    int menores = valores_posto(valores, valor);
+    printf("%d de %d transacoes (%.2f%%) tem valor menor que %.2f\n", menores, total, (menores * 100.0f) / total, valor);
+}
+
+// ================= PROGRAMA PRINCIPAL =================
+
+int main() {
+    load_csv("C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv");
+    int opcao;
+    char id[16];
+
+    do {
+        exibir_menu();
+        scanf("%d", &opcao);
+        limpar_buffer();
+
+        switch (opcao) {
+            case 1: {
+                printf("Digite o ID da transacao: ");
+                fgets(id, sizeof(id), stdin);
+                id[strcspn(id, "\n")] = '\0';
+
+                uint32_t r = search_bmais(id);
+                if (r) {
+                    exibir_transacao(registro(r));
+                } else {
+                    printf("Transacao nao encontrada.\n");
+                }
+                break;
+            }
+
+            case 2: {
+                printf("Digite o ID da transacao para remover: ");
+                fgets(id, sizeof(id), stdin);
+                id[strcspn(id, "\n")] = '\0';
+
+                if (delete_bmais(id))
+                    printf("Transacao removida com sucesso.\n");
+                else
+                    printf("Transacao nao encontrada.\n");
+                break;
+            }
+
+            case 3: {
+                Transaction t;
+                char is_fraud_str[6];
+
+                printf("Digite o ID da transacao: ");
+                fgets(t.transaction_id, sizeof(t.transaction_id), stdin);
+                printf("Digite o timestamp: ");
+                fgets(t.timestamp, sizeof(t.timestamp), stdin);
+                printf("Digite a conta do remetente: ");
+                fgets(t.sender_account, sizeof(t.sender_account), stdin);
+                printf("Digite a conta do destinatario: ");
+                fgets(t.receiver_account, sizeof(t.receiver_account), stdin);
+                printf("Digite o valor: ");
+                scanf("%f", &t.amount);
+                limpar_buffer();
+                printf("Digite o tipo de transacao: ");
+                fgets(t.transaction_type, sizeof(t.transaction_type), stdin);
+                printf("Digite a categoria do comerciante: ");
+                fgets(t.merchant_category, sizeof(t.merchant_category), stdin);
+                printf("Digite a localizacao: ");
+                fgets(t.location, sizeof(t.location), stdin);
+                printf("Digite o dispositivo usado: ");
+                fgets(t.device_used, sizeof(t.device_used), stdin);
+                printf("E fraude? (True/False): ");
+                fgets(is_fraud_str, sizeof(is_fraud_str), stdin);
+
+                // Remover quebras de linha
+                t.transaction_id[strcspn(t.transaction_id, "\n")] = '\0';
+                t.timestamp[strcspn(t.timestamp, "\n")] = '\0';
+                t.sender_account[strcspn(t.sender_account, "\n")] = '\0';
+                t.receiver_account[strcspn(t.receiver_account, "\n")] = '\0';
+                t.transaction_type[strcspn(t.transaction_type, "\n")] = '\0';
+                t.merchant_category[strcspn(t.merchant_category, "\n")] = '\0';
+                t.location[strcspn(t.location, "\n")] = '\0';
+                t.device_used[strcspn(t.device_used, "\n")] = '\0';
+                is_fraud_str[strcspn(is_fraud_str, "\n")] = '\0';
+
+                t.is_fraud = strcmp(is_fraud_str, "True") == 0;
+                if (insert_bmais(&t))
+                    printf("Transacao inserida com sucesso!\n");
+                else
+                    printf("Ja existe uma transacao com esse ID.\n");
+                break;
+            }
+
+            case 4:
+                calcular_estatisticas(indice_valores);
+                break;
+
+            case 5: {
+                exibir_campos_agrupamento();
+                int campo;
+                scanf("%d", &campo);
+                limpar_buffer();
+
+                if (campo < 1 || campo > 6) {
+                    printf("Opcao invalida!\n");
+                    break;
+                }
+
+                Grupo* grupos = NULL;
+                agrupar_transacoes(&grupos, campo);
+
+                const char* titulos[] = {"", "Tipo de Transacao", "Categoria do Comerciante",
+                                        "Localizacao", "Dispositivo Usado",
+                                        "Conta do Remetente", "Conta do Destinatario"};
+                imprimir_grupos(grupos, titulos[campo]);
+                liberar_grupos(grupos);
+                break;
+            }
+            case 6: {
+                exibir_campos_filtragem();
+                int campo;
+                scanf("%d", &campo);
+                limpar_buffer();
+                if (campo == 1) {
+                    float min_valor;
+                    printf("Digite o valor minimo da transacao: ");
+                    scanf("%f", &min_valor);
+                    limpar_buffer();
+                    filtrar_por_valor(min_valor);
+                } else if (campo >= 2 && campo <= 7) {
+                    char criterio[64];
+                    printf("Digite o valor do campo para filtrar: ");
+                    fgets(criterio, sizeof(criterio), stdin);
+                    criterio[strcspn(criterio, "\n")] = '\0';
+                    filtrar_transacoes(campo, criterio);
+                } else {
+                    printf("Campo invalido.\n");
+                }
+                break;
+            }
+
+            case 7:
+                printf("Encerrando o programa...\n");
+                break;
+
+            case 8:
+                consultar_percentil(indice_valores);
+                break;
+
+            case 9: {
+                char fim[16];
+                printf("Digite o ID inicial: ");
+                fgets(id, sizeof(id), stdin);
+                id[strcspn(id, "\n")] = '\0';
+                printf("Digite o ID final: ");
+                fgets(fim, sizeof(fim), stdin);
+                fim[strcspn(fim, "\n")] = '\0';
+                listar_intervalo_ids(id, fim);
+                break;
+            }
+
+            default:
+                printf("Opcao invalida! Tente novamente.\n");
+        }
+    } while (opcao != 7);
+
+    valores_liberar(indice_valores);
+    bmais_liberar(&indice_ids);
+    bmais_liberar(&indice_amounts);
+    pool_liberar(&registros);
+
+    return 0;
+}
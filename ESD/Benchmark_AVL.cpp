@@ -4,8 +4,12 @@
 #include <stdbool.h>
 #include <math.h>
 #include <stdint.h>
+#include <stddef.h>
 #include <windows.h> // Necessario para HighPrecisionTimer e Sleep
 #include <time.h>    // Necessario para srand, time
+#include "pool_indices.h"
+#include "cursor_arvore.h"
+#include "arvore_bmais.h"
 
 #ifdef _MSC_VER
 #define _CRT_SECURE_NO_WARNINGS
@@ -29,19 +33,22 @@ typedef struct Transaction {
     bool is_fraud;
 } Transaction;
 
-// Estrutura para um no de arvore AVL
+// Estrutura para um no de arvore AVL: so o que a busca le. A transacao fica
+// no deposito de registros da arvore e o no guarda o indice dela
 typedef struct AVLNode {
     int key; // Chave numerica usada para a ordenacao da arvore AVL
-    Transaction data; // Dados da transacao armazenados no no
-    struct AVLNode* left; // Ponteiro para o filho esquerdo
-    struct AVLNode* right; // Ponteiro para o filho direito
+    uint32_t registro; // Indice da transacao no deposito de registros
+    uint32_t left; // Indice do filho esquerdo no pool de nos (0 = nenhum)
+    uint32_t right; // Indice do filho direito no pool de nos (0 = nenhum)
     uint8_t height; // Altura do no na arvore
 } AVLNode;
 
-// Estrutura para a Arvore AVL, contendo a raiz e o numero de elementos
+// Estrutura para a Arvore AVL: pools de nos e de transacoes, a raiz e o numero de elementos
 typedef struct AVLTree {
-    AVLNode* root; // Ponteiro para a raiz da arvore
-    int size;      // Numero de elementos na arvore
+    PoolIndices nos;       // AVLNode (pool_indices.h)
+    PoolIndices registros; // Transaction de cada no
+    uint32_t root;         // Indice da raiz (0 = arvore vazia)
+    int size;              // Numero de elementos na arvore
 } AVLTree;
 
 // Estrutura para simular MachineData para o printf
@@ -67,55 +74,66 @@ typedef struct MachineData_Simulated {
 // Retorna o maximo entre dois inteiros
 int max(int a, int b) { return (a > b) ? a : b; }
 
-// Retorna a altura de um no (0 se o no for NULL)
-int height(AVLNode* node) { return node ? node->height : 0; }
+// No de indice "i" (o ponteiro vale ate a proxima insercao, que pode mover o pool)
+AVLNode* no_avl(const AVLTree* tree, uint32_t i) { return (AVLNode*)pool_item(&tree->nos, i); }
+
+// Transacao guardada por um no
+Transaction* registro_no(const AVLTree* tree, const AVLNode* node) {
+    return (Transaction*)pool_item(&tree->registros, node->registro);
+}
+
+// Retorna a altura de um no (0 se o indice for 0)
+int height(const AVLTree* tree, uint32_t node) { return node ? no_avl(tree, node)->height : 0; }
 
 // Retorna o fator de balanceamento de um no (altura do filho esquerdo - altura do filho direito)
-int get_balance(AVLNode* node) {
-    return node ? height(node->left) - height(node->right) : 0;
+int get_balance(const AVLTree* tree, uint32_t node) {
+    return node ? height(tree, no_avl(tree, node)->left) - height(tree, no_avl(tree, node)->right) : 0;
 }
 
 // Cria um novo no com a chave e os dados fornecidos
-AVLNode* create_node(int key, Transaction data) {
-    AVLNode* node = (AVLNode*)malloc(sizeof(AVLNode));
-    if (node == NULL) {
-        perror("Erro de alocacao de memoria para AVLNode");
-        exit(EXIT_FAILURE);
-    }
-    node->key = key;
-    node->data = data;
-    node->left = NULL;
-    node->right = NULL;
-    node->height = 1; // Novo no tem altura 1
+uint32_t create_node(AVLTree* tree, int key, const Transaction* data) {
+    uint32_t registro = pool_alocar(&tree->registros);
+    *(Transaction*)pool_item(&tree->registros, registro) = *data;
+    uint32_t node = pool_alocar(&tree->nos);
+    AVLNode* n = no_avl(tree, node);
+    n->key = key;
+    n->registro = registro;
+    n->left = 0;
+    n->right = 0;
+    n->height = 1; // Novo no tem altura 1
     return node;
 }
 
 // Rotacao a direita no no y
-AVLNode* right_rotate(AVLNode* y) {
-    AVLNode* x = y->left;
-    AVLNode* T2 = x->right;
+uint32_t right_rotate(AVLTree* tree, uint32_t y) {
+    AVLNode* ny = no_avl(tree, y);
+    uint32_t x = ny->left;
+    AVLNode* nx = no_avl(tree, x);
+    uint32_t T2 = nx->right;
 
-    x->right = y;
-    y->left = T2;
+    nx->right = y;
+    ny->left = T2;
 
     // Atualiza alturas
-    y->height = 1 + max(height(y->left), height(y->right));
-    x->height = 1 + max(height(x->left), height(x->right));
+    ny->height = 1 + max(height(tree, ny->left), height(tree, ny->right));
+    nx->height = 1 + max(height(tree, nx->left), height(tree, nx->right));
 
     return x; // Retorna a nova raiz da subarvore rotacionada
 }
 
 // Rotacao a esquerda no no x
-AVLNode* left_rotate(AVLNode* x) {
-    AVLNode* y = x->right;
-    AVLNode* T2 = y->left;
+uint32_t left_rotate(AVLTree* tree, uint32_t x) {
+    AVLNode* nx = no_avl(tree, x);
+    uint32_t y = nx->right;
+    AVLNode* ny = no_avl(tree, y);
+    uint32_t T2 = ny->left;
 
-    y->left = x;
-    x->right = T2;
+    ny->left = x;
+    nx->right = T2;
 
     // Atualiza alturas
-    x->height = 1 + max(height(x->left), height(x->right));
-    y->height = 1 + max(height(y->left), height(y->right));
+    nx->height = 1 + max(height(tree, nx->left), height(tree, nx->right));
+    ny->height = 1 + max(height(tree, ny->left), height(tree, ny->right));
 
     return y; // Retorna a nova raiz da subarvore rotacionada
 }
@@ -123,46 +141,52 @@ AVLNode* left_rotate(AVLNode* x) {
 // ================= FUNCOES AVL (ADAPTADAS PARA BENCHMARKS) =================
 
 // Funcao recursiva de insercao AVL (controla o tamanho)
-AVLNode* insert_node_avl_benchmark(AVLNode* node, int key, Transaction data, int* size_ptr) {
+uint32_t insert_node_avl_benchmark(AVLTree* tree, uint32_t node, int key, const Transaction* data, int* size_ptr) {
     // 1. Realiza a insercao BST padrao
-    if (node == NULL) {
+    if (node == 0) {
         if (size_ptr) (*size_ptr)++; // Incrementa o tamanho da arvore
-        return create_node(key, data);
+        return create_node(tree, key, data);
     }
 
-    if (key < node->key) {
-        node->left = insert_node_avl_benchmark(node->left, key, data, size_ptr);
-    } else if (key > node->key) {
-        node->right = insert_node_avl_benchmark(node->right, key, data, size_ptr);
+    // A insercao pode mover o pool: o filho so e gravado depois da chamada
+    uint32_t child;
+    if (key < no_avl(tree, node)->key) {
+        child = insert_node_avl_benchmark(tree, no_avl(tree, node)->left, key, data, size_ptr);
+        no_avl(tree, node)->left = child;
+    } else if (key > no_avl(tree, node)->key) {
+        child = insert_node_avl_benchmark(tree, no_avl(tree, node)->right, key, data, size_ptr);
+        no_avl(tree, node)->right = child;
     } else { // Chave duplicada
         return node; 
     }
 
+    AVLNode* n = no_avl(tree, node);
+
     // 2. Atualiza a altura deste no ancestral
-    node->height = 1 + max(height(node->left), height(node->right));
+    n->height = 1 + max(height(tree, n->left), height(tree, n->right));
 
     // 3. Obtem o fator de balanceamento deste no ancestral
-    int balance = get_balance(node);
+    int balance = get_balance(tree, node);
 
     // 4. Se este no se torna desbalanceado, ha 4 casos:
     // Caso Esquerda-Esquerda
-    if (balance > 1 && key < node->left->key)
-        return right_rotate(node);
+    if (balance > 1 && key < no_avl(tree, n->left)->key)
+        return right_rotate(tree, node);
 
     // Caso Direita-Direita
-    if (balance < -1 && key > node->right->key)
-        return left_rotate(node);
+    if (balance < -1 && key > no_avl(tree, n->right)->key)
+        return left_rotate(tree, node);
 
     // Caso Esquerda-Direita
-    if (balance > 1 && key > node->left->key) {
-        node->left = left_rotate(node->left);
-        return right_rotate(node);
+    if (balance > 1 && key > no_avl(tree, n->left)->key) {
+        n->left = left_rotate(tree, n->left);
+        return right_rotate(tree, node);
     }
 
     // Caso Direita-Esquerda
-    if (balance < -1 && key < node->right->key) {
-        node->right = right_rotate(node->right);
-        return left_rotate(node);
+    if (balance < -1 && key < no_avl(tree, n->right)->key) {
+        n->right = right_rotate(tree, n->right);
+        return left_rotate(tree, node);
     }
 
     return node;
@@ -170,92 +194,90 @@ AVLNode* insert_node_avl_benchmark(AVLNode* node, int key, Transaction data, int
 
 // Wrapper para insercao AVL
 void insertAVLTree(AVLTree* tree, int key, Transaction data) {
-    tree->root = insert_node_avl_benchmark(tree->root, key, data, &(tree->size));
+    tree->root = insert_node_avl_benchmark(tree, tree->root, key, &data, &(tree->size));
 }
 
 // Funcao recursiva de busca AVL
-AVLNode* search_avl_node_benchmark(AVLNode* node, int key) {
-    if (node == NULL || node->key == key) {
+uint32_t search_avl_node_benchmark(const AVLTree* tree, uint32_t node, int key) {
+    if (node == 0 || no_avl(tree, node)->key == key) {
         return node;
     }
-    if (node->key < key) {
-        return search_avl_node_benchmark(node->right, key);
+    if (no_avl(tree, node)->key < key) {
+        return search_avl_node_benchmark(tree, no_avl(tree, node)->right, key);
     }
-    return search_avl_node_benchmark(node->left, key);
+    return search_avl_node_benchmark(tree, no_avl(tree, node)->left, key);
 }
 
 // Wrapper para busca AVL
 AVLNode* searchAVLTree(AVLTree* tree, int key) {
-    return search_avl_node_benchmark(tree->root, key);
+    uint32_t node = search_avl_node_benchmark(tree, tree->root, key);
+    return node ? no_avl(tree, node) : NULL;
 }
 
 // Funcao recursiva de delecao AVL (controla o tamanho)
-AVLNode* delete_node_avl_benchmark(AVLNode* root, int key, int* size_ptr) {
+uint32_t delete_node_avl_benchmark(AVLTree* tree, uint32_t root, int key, int* size_ptr) {
     // PASSO 1: Realiza a delecao BST padrao
-    if (root == NULL) return root;
+    if (root == 0) return root;
 
-    if (key < root->key) {
-        root->left = delete_node_avl_benchmark(root->left, key, size_ptr);
-    } else if (key > root->key) {
-        root->right = delete_node_avl_benchmark(root->right, key, size_ptr);
+    AVLNode* n = no_avl(tree, root);
+    if (key < n->key) {
+        n->left = delete_node_avl_benchmark(tree, n->left, key, size_ptr);
+    } else if (key > n->key) {
+        n->right = delete_node_avl_benchmark(tree, n->right, key, size_ptr);
     } else { // No com a chave a ser deletada encontrado
-        // No com apenas um filho ou sem filho
-        if ((root->left == NULL) || (root->right == NULL)) {
-            AVLNode* temp = root->left ? root->left : root->right;
-
-            // Caso sem filho
-            if (temp == NULL) {
-                temp = root;
-                root = NULL;
-            } else { // Caso com um filho
-                *root = *temp; 
-            }
-            free(temp);
+        // No com apenas um filho ou sem filho: o filho (ou 0) assume o lugar
+        if (n->left == 0 || n->right == 0) {
+            uint32_t temp = n->left ? n->left : n->right;
+            pool_devolver(&tree->registros, n->registro);
+            pool_devolver(&tree->nos, root);
             if (size_ptr) (*size_ptr)--; 
-        } else {
-            // No com dois filhos: Obtem o sucessor in-order (menor na subarvore direita)
-            AVLNode* temp = root->right;
-            while (temp->left != NULL) {
-                temp = temp->left;
-            }
-
-            // Copia a chave e os dados do sucessor in-order para este no
-            root->key = temp->key;
-            root->data = temp->data;
-
-            // Deleta o sucessor in-order
-            root->right = delete_node_avl_benchmark(root->right, temp->key, size_ptr);
+            return temp;
+        }
+        // No com dois filhos: troca chave e registro com o sucessor in-order
+        // (menor na subarvore direita), sem copiar a transacao. A chave
+        // removida fica no sucessor e e menor que toda a subarvore direita,
+        // entao a delecao abaixo desce sempre a esquerda ate ele
+        uint32_t temp = n->right;
+        while (no_avl(tree, temp)->left != 0) {
+            temp = no_avl(tree, temp)->left;
         }
+        AVLNode* s = no_avl(tree, temp);
+        int temp_key = s->key;
+        uint32_t temp_registro = s->registro;
+        s->key = n->key;
+        s->registro = n->registro;
+        n->key = temp_key;
+        n->registro = temp_registro;
+
+        // Deleta o sucessor in-order
+        n->right = delete_node_avl_benchmark(tree, n->right, key, size_ptr);
     }
 
-    // Se a arvore tinha apenas um no, retorna
-    if (root == NULL) return root;
-
     // PASSO 2: Atualiza a altura do no atual
-    root->height = 1 + max(height(root->left), height(root->right));
+    n->height = 1 + max(height(tree, n->left), height(tree, n->right));
 
     // PASSO 3: Obtem o fator de balanceamento deste no
-    int balance = get_balance(root);
+    int balance = get_balance(tree, root);
 
     // Se este no se torna desbalanceado, ha 4 casos:
     // Caso Esquerda-Esquerda
-    if (balance > 1 && get_balance(root->left) >= 0)
-        return right_rotate(root);
+    if (balance > 1 && get_balance(tree, n->left) >= 0)
+        return right_rotate(tree, root);
 
     // Caso Esquerda-Direita
-    if (balance > 1 && get_balance(root->left) < 0) {
-        root->left = left_rotate(root->left);
-        return right_rotate(root);
+    if (balance > 1 && get_balance(tree, n->left) < 0) {
+        n->left = left_rotate(tree, n->left);
+        return right_rotate(tree, root);
     }
 
     // Caso Direita-Direita
-    if (balance < -1 && get_balance(root->right) <= 0)
-        return left_rotate(root);
+    if (balance < -1 && get_balance(tree, n->right) <= 0)
+        return left_rotate(tree, root);
 
     // Caso Direita-Esquerda
-    if (balance < -1 && get_balance(root->right) > 0) {
-        root->right = right_rotate(root->right);
-        return left_rotate(root);
+    if (balance < -1 && get_balance(tree, n->right) > 0) {
+        n->right = right_rotate(tree, n->right);
+        return left_rotate(tree, root);
     }
 
     return root;
@@ -263,23 +285,122 @@ AVLNode* delete_node_avl_benchmark(AVLNode* root, int key, int* size_ptr) {
 
 // Wrapper para delecao AVL
 void deleteAVLTree(AVLTree* tree, int key) {
-    tree->root = delete_node_avl_benchmark(tree->root, key, &(tree->size));
-}
-
-// Libera recursivamente todos os nos na arvore
-void freeAVLTree(AVLNode* node) {
-    if (node == NULL) return;
-    freeAVLTree(node->left);
-    freeAVLTree(node->right);
-    free(node);
+    tree->root = delete_node_avl_benchmark(tree, tree->root, key, &(tree->size));
 }
 
 // Inicializa uma estrutura AVLTree
 void initAVLTree(AVLTree* tree) {
-    tree->root = NULL;
+    pool_iniciar(&tree->nos, sizeof(AVLNode));
+    pool_iniciar(&tree->registros, sizeof(Transaction));
+    tree->root = 0;
     tree->size = 0;
 }
 
+// Libera todos os nos da arvore de uma vez (sao dois blocos) e a deixa vazia
+void freeAVLTree(AVLTree* tree) {
+    pool_liberar(&tree->nos);
+    pool_liberar(&tree->registros);
+    tree->root = 0;
+    tree->size = 0;
+}
+
+// Copia a arvore inteira em O(n): os pools sao copiados como estao e os
+// indices continuam valendo, sem reinserir no a no
+void cloneAVLTree(AVLTree* dest, const AVLTree* src) {
+    pool_copiar(&dest->nos, &src->nos);
+    pool_copiar(&dest->registros, &src->registros);
+    dest->root = src->root;
+    dest->size = src->size;
+}
+
+// Par chave/transacao usado na construcao em lote
+typedef struct BulkEntry {
+    int key;
+    uint32_t registro;
+} BulkEntry;
+
+// Ordem de chave; chaves repetidas ficam na ordem de entrada
+int compare_bulk_entries(const void* a, const void* b) {
+    const BulkEntry* x = (const BulkEntry*)a;
+    const BulkEntry* y = (const BulkEntry*)b;
+    if (x->key != y->key) return (x->key > y->key) - (x->key < y->key);
+    return (x->registro > y->registro) - (x->registro < y->registro);
+}
+
+// Subarvore perfeitamente balanceada de e[begin, end): o meio vira a raiz
+uint32_t build_balanced(AVLTree* tree, const BulkEntry* e, int begin, int end) {
+    if (begin >= end) return 0;
+    int mid = begin + (end - begin) / 2;
+    uint32_t node = pool_alocar(&tree->nos);
+    uint32_t left = build_balanced(tree, e, begin, mid);
+    uint32_t right = build_balanced(tree, e, mid + 1, end);
+    AVLNode* n = no_avl(tree, node);
+    n->key = e[mid].key;
+    n->registro = e[mid].registro;
+    n->left = left;
+    n->right = right;
+    n->height = 1 + max(height(tree, left), height(tree, right));
+    return node;
+}
+
+// Constroi a arvore (vazia) de uma vez a partir de n chaves e transacoes:
+// confere se as chaves ja estao em ordem e so ordena se nao estiverem;
+// chaves repetidas ficam so com a primeira, como em insertAVLTree. O(n) com
+// entrada ordenada, O(n log n) do qsort caso contrario
+void bulkLoadAVLTree(AVLTree* tree, const int* keys, const Transaction* data, int n) {
+    BulkEntry* e = (BulkEntry*)malloc((n > 0 ? n : 1) * sizeof(BulkEntry));
+    if (e == NULL) {
+        perror("Erro de alocacao de memoria para a carga em lote");
+        exit(EXIT_FAILURE);
+    }
+    pool_reservar(&tree->registros, (uint32_t)n + 1);
+    bool sorted = true;
+    for (int i = 0; i < n; i++) {
+        e[i].key = keys[i];
+        e[i].registro = pool_alocar(&tree->registros);
+        *(Transaction*)pool_item(&tree->registros, e[i].registro) = data[i];
+        if (i > 0 && keys[i - 1] >= keys[i]) sorted = false;
+    }
+    if (!sorted) qsort(e, n, sizeof(BulkEntry), compare_bulk_entries);
+
+    int unique = 0;
+    for (int i = 0; i < n; i++) {
+        if (unique > 0 && e[unique - 1].key == e[i].key) {
+            pool_devolver(&tree->registros, e[i].registro);
+            continue;
+        }
+        e[unique++] = e[i];
+    }
+
+    pool_reservar(&tree->nos, (uint32_t)unique + 1);
+    tree->root = build_balanced(tree, e, 0, unique);
+    tree->size = unique;
+    free(e);
+}
+
+// Percurso em ordem sem recursao (cursor_arvore.h)
+AVLNode* primeiro_no(CursorArvore* it, const AVLTree* tree) {
+    return (AVLNode*)cursor_primeiro(it, tree->nos.itens, sizeof(AVLNode), tree->root,
+                                     offsetof(AVLNode, left), offsetof(AVLNode, right));
+}
+
+AVLNode* proximo_no(CursorArvore* it) {
+    return (AVLNode*)cursor_proximo(it);
+}
+
+// Menor e maior no da arvore (NULL se vazia)
+AVLNode* min_node(const AVLTree* tree) {
+    uint32_t node = tree->root;
+    while (node && no_avl(tree, node)->left) node = no_avl(tree, node)->left;
+    return node ? no_avl(tree, node) : NULL;
+}
+
+AVLNode* max_node(const AVLTree* tree) {
+    uint32_t node = tree->root;
+    while (node && no_avl(tree, node)->right) node = no_avl(tree, node)->right;
+    return node ? no_avl(tree, node) : NULL;
+}
+
 // ================= FUNCOES AUXILIARES PARA ESTATISTICAS =================
 
 // Calcula a media de um array de doubles
@@ -328,27 +449,35 @@ double stop_timer(HighPrecisionTimer* timer) {
     return elapsed;
 }
 
+// Preenche uma transacao aleatoria (a i-esima gerada) e retorna sua chave
+int fillRandomTransaction(Transaction* out, int i) {
+    Transaction d = {0}; 
+    int udi_key = 10000 + i + rand() % 100000; // Garante UDI unico para AVL
+
+    // Preenche os campos da transacao com dados aleatorios
+    snprintf(d.transaction_id, sizeof(d.transaction_id), "TRN%08d", udi_key);
+    snprintf(d.timestamp, sizeof(d.timestamp), "2024-01-01 %02d:%02d:%02d", rand() % 24, rand() % 60, rand() % 60);
+    snprintf(d.sender_account, sizeof(d.sender_account), "ACC%05d", rand() % 100000);
+    snprintf(d.receiver_account, sizeof(d.receiver_account), "ACC%05d", rand() % 100000);
+    d.amount = 10.0f + (rand() % 10000) / 100.0f;
+    char types[][16] = {"purchase", "transfer", "deposit", "withdrawal", "payment"};
+    snprintf(d.transaction_type, sizeof(d.transaction_type), "%s", types[rand() % 5]);
+    char categories[][32] = {"retail", "food", "travel", "online", "services", "utilities", "healthcare"};
+    snprintf(d.merchant_category, sizeof(d.merchant_category), "%s", categories[rand() % 7]);
+    snprintf(d.location, sizeof(d.location), "City%03d", rand() % 500);
+    char devices[][16] = {"mobile", "web", "pos", "atm"};
+    snprintf(d.device_used, sizeof(d.device_used), "%s", devices[rand() % 4]);
+    d.is_fraud = (rand() % 100 < 5); // 5% de chance de ser fraude
+
+    *out = d;
+    return udi_key;
+}
+
 // Gera um conjunto de dados aleatorios e os insere em uma AVLTree
 void generateRandomData(AVLTree* tree, int count) {
     for (int i = 0; i < count; i++) {
-        Transaction d = {0}; 
-        int udi_key = 10000 + i + rand() % 100000; // Garante UDI unico para AVL
-
-        // Preenche os campos da transacao com dados aleatorios
-        snprintf(d.transaction_id, sizeof(d.transaction_id), "TRN%08d", udi_key);
-        snprintf(d.timestamp, sizeof(d.timestamp), "2024-01-01 %02d:%02d:%02d", rand() % 24, rand() % 60, rand() % 60);
-        snprintf(d.sender_account, sizeof(d.sender_account), "ACC%05d", rand() % 100000);
-        snprintf(d.receiver_account, sizeof(d.receiver_account), "ACC%05d", rand() % 100000);
-        d.amount = 10.0f + (rand() % 10000) / 100.0f;
-        char types[][16] = {"purchase", "transfer", "deposit", "withdrawal", "payment"};
-        snprintf(d.transaction_type, sizeof(d.transaction_type), "%s", types[rand() % 5]);
-        char categories[][32] = {"retail", "food", "travel", "online", "services", "utilities", "healthcare"};
-        snprintf(d.merchant_category, sizeof(d.merchant_category), "%s", categories[rand() % 7]);
-        snprintf(d.location, sizeof(d.location), "City%03d", rand() % 500);
-        char devices[][16] = {"mobile", "web", "pos", "atm"};
-        snprintf(d.device_used, sizeof(d.device_used), "%s", devices[rand() % 4]);
-        d.is_fraud = (rand() % 100 < 5); // 5% de chance de ser fraude
-
+        Transaction d;
+        int udi_key = fillRandomTransaction(&d, i);
         insertAVLTree(tree, udi_key, d);
     }
 }
@@ -367,7 +496,7 @@ void benchmark_insertion(AVLTree* tree_param, int num_elements) {
         generateRandomData(&tmp, num_elements);
         results[i] = stop_timer(&t);
         
-        freeAVLTree(tmp.root); // Libera memoria da arvore temporaria
+        freeAVLTree(&tmp); // Libera memoria da arvore temporaria
     }
 
     double mean = calculate_mean(results, NUM_REPETITIONS);
@@ -379,6 +508,63 @@ void benchmark_insertion(AVLTree* tree_param, int num_elements) {
     printf("  Coeficiente de Variacao: %.2f%%\n", cov);
 }
 
+// Compara a construcao por insercoes com a carga em lote, com os mesmos
+// dados ja gerados (a geracao fica fora do tempo) em ordem aleatoria e ordenados
+void benchmark_bulk_load(int num_elements) {
+    double results_insert[NUM_REPETITIONS], results_bulk[NUM_REPETITIONS], results_sorted[NUM_REPETITIONS];
+    printf("\nBenchmark Carga em Lote (%d elementos):\n", num_elements);
+
+    int* keys = (int*)malloc(num_elements * sizeof(int));
+    Transaction* data = (Transaction*)malloc(num_elements * sizeof(Transaction));
+    if (!keys || !data) {
+        perror("Erro ao alocar dados para a carga em lote");
+        free(keys);
+        free(data);
+        return;
+    }
+
+    for (int i = 0; i < NUM_REPETITIONS; i++) {
+        HighPrecisionTimer t;
+        AVLTree tmp;
+        for (int j = 0; j < num_elements; j++)
+            keys[j] = fillRandomTransaction(&data[j], j);
+
+        initAVLTree(&tmp);
+        start_timer(&t);
+        for (int j = 0; j < num_elements; j++)
+            insertAVLTree(&tmp, keys[j], data[j]);
+        results_insert[i] = stop_timer(&t);
+        freeAVLTree(&tmp);
+
+        initAVLTree(&tmp);
+        start_timer(&t);
+        bulkLoadAVLTree(&tmp, keys, data, num_elements);
+        results_bulk[i] = stop_timer(&t);
+
+        // Reaproveita a ordem da arvore para ter a entrada ja ordenada
+        CursorArvore it;
+        int j = 0;
+        for (AVLNode* node = primeiro_no(&it, &tmp); node; node = proximo_no(&it), j++) {
+            keys[j] = node->key;
+            data[j] = *registro_no(&tmp, node);
+        }
+        int unique = tmp.size;
+        freeAVLTree(&tmp);
+
+        initAVLTree(&tmp);
+        start_timer(&t);
+        bulkLoadAVLTree(&tmp, keys, data, unique);
+        results_sorted[i] = stop_timer(&t);
+        freeAVLTree(&tmp);
+    }
+
+    printf("  Insercoes uma a uma: %.3f ms\n", calculate_mean(results_insert, NUM_REPETITIONS));
+    printf("  Lote (entrada aleatoria, com qsort): %.3f ms\n", calculate_mean(results_bulk, NUM_REPETITIONS));
+    printf("  Lote (entrada ja ordenada): %.3f ms\n", calculate_mean(results_sorted, NUM_REPETITIONS));
+    free(keys);
+    free(data);
+}
+
 // Realiza o benchmark de busca
 void benchmark_search(AVLTree* tree) {
     if (tree->size == 0) {
@@ -390,14 +576,8 @@ void benchmark_search(AVLTree* tree) {
     printf("\nBenchmark Busca (%d ops):\n", 10000); // 10000 ops e o numero de buscas por repeticao
 
     // Encontra o menor e maior UDI para o intervalo de busca (fora do loop de repeticoes para consistencia)
-    AVLNode* minNode = tree->root;
-    while (minNode != NULL && minNode->left != NULL) {
-        minNode = minNode->left;
-    }
-    AVLNode* maxNode = tree->root;
-    while (maxNode != NULL && maxNode->right != NULL) {
-        maxNode = maxNode->right;
-    }
+    AVLNode* minNode = min_node(tree);
+    AVLNode* maxNode = max_node(tree);
     
     int minUDI = minNode ? minNode->key : 0; 
     int maxUDI = maxNode ? maxNode->key : 0; 
@@ -448,26 +628,9 @@ void benchmark_removal(AVLTree* tree) {
     for (int i = 0; i < NUM_REPETITIONS; i++) {
         HighPrecisionTimer t;
         AVLTree tmp; 
-        initAVLTree(&tmp);
         
-        // Copia os elementos para uma arvore temporaria para remocao
-        AVLNode** stack = (AVLNode**)malloc((tree->size + 1) * sizeof(AVLNode*)); 
-        if (!stack) {
-            perror("Erro ao alocar stack para travessia");
-            return;
-        }
-        int top = -1;
-        AVLNode* current_original = tree->root;
-        while (current_original != NULL || top != -1) {
-            while (current_original != NULL) {
-                stack[++top] = current_original;
-                current_original = current_original->left;
-            }
-            current_original = stack[top--];
-            insertAVLTree(&tmp, current_original->key, current_original->data);
-            current_original = current_original->right;
-        }
-        free(stack);
+        // Copia a arvore para uma temporaria para remocao
+        cloneAVLTree(&tmp, tree);
 
         const int removals_per_run = (tmp.size < 1000) ? tmp.size / 2 : 1000; 
         if (removals_per_run == 0 && tmp.size > 0) {
@@ -478,31 +641,16 @@ void benchmark_removal(AVLTree* tree) {
         int* keys_to_remove = (int*)malloc(tmp.size * sizeof(int));
         if (keys_to_remove == NULL) {
             perror("Erro ao alocar memoria para keys_to_remove");
-            freeAVLTree(tmp.root);
+            freeAVLTree(&tmp);
             return;
         }
         int count_keys = 0;
-        AVLNode** temp_stack = (AVLNode**)malloc((tmp.size + 1) * sizeof(AVLNode*)); 
-        if (!temp_stack) {
-            perror("Erro ao alocar temp_stack para travessia");
-            free(keys_to_remove);
-            freeAVLTree(tmp.root);
-            return;
-        }
-        top = -1;
-        AVLNode* current_tmp = tmp.root;
-        while (current_tmp != NULL || top != -1) {
-            while (current_tmp != NULL) {
-                temp_stack[++top] = current_tmp;
-                current_tmp = current_tmp->left;
-            }
-            current_tmp = temp_stack[top--];
+        CursorArvore it;
+        for (AVLNode* node = primeiro_no(&it, &tmp); node; node = proximo_no(&it)) {
             if (count_keys < tmp.size) { 
-                keys_to_remove[count_keys++] = current_tmp->key;
+                keys_to_remove[count_keys++] = node->key;
             }
-            current_tmp = current_tmp->right;
         }
-        free(temp_stack);
 
         // Embaralha as chaves para remocao aleatoria
         for (int k = count_keys - 1; k > 0; k--) {
@@ -521,7 +669,7 @@ void benchmark_removal(AVLTree* tree) {
         results[i] = stop_timer(&t);
 
         free(keys_to_remove);
-        freeAVLTree(tmp.root); 
+        freeAVLTree(&tmp); 
     }
 
     double mean = calculate_mean(results, NUM_REPETITIONS);
@@ -533,9 +681,9 @@ void benchmark_removal(AVLTree* tree) {
     printf("  Coeficiente de Variacao: %.2f%%\n", cov);
 }
 
-// Calcula o tamanho em bytes de um no AVL
+// Calcula o tamanho em bytes de um elemento: o no AVL mais a transacao no deposito
 size_t calculate_node_size() {
-    return sizeof(AVLNode); 
+    return sizeof(AVLNode) + sizeof(Transaction); 
 }
 
 // Estima o uso de memoria da arvore
@@ -549,7 +697,7 @@ void estimate_memory_usage(AVLTree* tree) {
     size_t total_memory = tree->size * node_size + sizeof(AVLTree);
     
     printf("\n=== ESTIMATIVA DE USO DE MEMORIA ===\n"); 
-    printf("Tamanho por no: %zu bytes\n", node_size); 
+    printf("Tamanho por no: %zu bytes (%zu do no + %zu da transacao)\n", node_size, sizeof(AVLNode), sizeof(Transaction)); 
     printf("Numero de nos: %d\n", tree->size); 
     printf("Memoria total estimada: %zu bytes (%.2f KB)\n", 
            total_memory, (float)total_memory / 1024);
@@ -557,9 +705,347 @@ void estimate_memory_usage(AVLTree* tree) {
     printf("\nComparacao com sizeof:\n"); 
     printf("sizeof(MachineData): %zu bytes\n", sizeof(Transaction)); 
     printf("sizeof(AVLNode): %zu bytes\n", sizeof(AVLNode));
+    printf("Reservado nos pools: %zu bytes (nos) + %zu bytes (transacoes)\n",
+           pool_memoria(&tree->nos), pool_memoria(&tree->registros));
     printf("Obs: Pode haver padding/alignment pelo compilador\n"); 
 }
 
+// ================= LAYOUT ANTIGO DO NO (COMPARACAO) =================
+
+// No como era antes de separar chave e transacao: a Transaction embutida e
+// ponteiros para os filhos. Fica aqui so para medir a busca contra o layout atual
+typedef struct NoAntigo {
+    int key;
+    Transaction data;
+    struct NoAntigo* left;
+    struct NoAntigo* right;
+    uint8_t height;
+} NoAntigo;
+
+int altura_antigo(NoAntigo* node) { return node ? node->height : 0; }
+
+NoAntigo* rotacao_direita_antigo(NoAntigo* y) {
+    NoAntigo* x = y->left;
+    y->left = x->right;
+    x->right = y;
+    y->height = 1 + max(altura_antigo(y->left), altura_antigo(y->right));
+    x->height = 1 + max(altura_antigo(x->left), altura_antigo(x->right));
+    return x;
+}
+
+NoAntigo* rotacao_esquerda_antigo(NoAntigo* x) {
+    NoAntigo* y = x->right;
+    x->right = y->left;
+    y->left = x;
+    x->height = 1 + max(altura_antigo(x->left), altura_antigo(x->right));
+    y->height = 1 + max(altura_antigo(y->left), altura_antigo(y->right));
+    return y;
+}
+
+// Mesma insercao de insert_node_avl_benchmark, com nos alocados um a um
+NoAntigo* inserir_antigo(NoAntigo* node, int key, const Transaction* data) {
+    if (node == NULL) {
+        node = (NoAntigo*)malloc(sizeof(NoAntigo));
+        if (node == NULL) {
+            perror("Erro de alocacao de memoria para NoAntigo");
+            exit(EXIT_FAILURE);
+        }
+        node->key = key;
+        node->data = *data;
+        node->left = node->right = NULL;
+        node->height = 1;
+        return node;
+    }
+    if (key < node->key)
+        node->left = inserir_antigo(node->left, key, data);
+    else if (key > node->key)
+        node->right = inserir_antigo(node->right, key, data);
+    else
+        return node;
+
+    node->height = 1 + max(altura_antigo(node->left), altura_antigo(node->right));
+    int balance = altura_antigo(node->left) - altura_antigo(node->right);
+    if (balance > 1 && key < node->left->key) return rotacao_direita_antigo(node);
+    if (balance < -1 && key > node->right->key) return rotacao_esquerda_antigo(node);
+    if (balance > 1 && key > node->left->key) {
+        node->left = rotacao_esquerda_antigo(node->left);
+        return rotacao_direita_antigo(node);
+    }
+    if (balance < -1 && key < node->right->key) {
+        node->right = rotacao_direita_antigo(node->right);
+        return rotacao_esquerda_antigo(node);
+    }
+    return node;
+}
+
+// Mesma busca de search_avl_node_benchmark
+NoAntigo* buscar_antigo(NoAntigo* node, int key) {
+    if (node == NULL || node->key == key) return node;
+    if (node->key < key) return buscar_antigo(node->right, key);
+    return buscar_antigo(node->left, key);
+}
+
+void liberar_antigo(NoAntigo* node) {
+    if (node == NULL) return;
+    liberar_antigo(node->left);
+    liberar_antigo(node->right);
+    free(node);
+}
+
+// Inteiro aleatorio de 30 bits (o RAND_MAX do Windows e so 32767)
+int rand_grande() {
+    return ((rand() & 0x7FFF) << 15) | (rand() & 0x7FFF);
+}
+
+// Vazao de buscas com o no antigo (Transaction embutida, ~260 bytes) e com o
+// atual (indices em pool, transacao a parte), mesmas chaves e mesma ordem
+void benchmark_node_layout() {
+    printf("\nBenchmark Layout do No (buscas por segundo, antes e depois):\n");
+    printf("  sizeof(NoAntigo): %zu bytes | sizeof(AVLNode): %zu bytes\n", sizeof(NoAntigo), sizeof(AVLNode));
+    int sizes[] = {10000, 100000, 500000};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    const int searches_per_run = 1000000;
+    int* keys = (int*)malloc(sizes[num_sizes - 1] * sizeof(int));
+    int* queries = (int*)malloc(searches_per_run * sizeof(int));
+    if (!keys || !queries) {
+        perror("Erro ao alocar chaves do benchmark de layout");
+        free(keys);
+        free(queries);
+        return;
+    }
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        AVLTree tree;
+        initAVLTree(&tree);
+        NoAntigo* antiga = NULL;
+        for (int i = 0; i < n; i++) {
+            Transaction d = {0};
+            keys[i] = rand_grande();
+            snprintf(d.transaction_id, sizeof(d.transaction_id), "TRN%08d", keys[i]);
+            d.amount = 10.0f + (rand() % 10000) / 100.0f;
+            insertAVLTree(&tree, keys[i], d);
+            antiga = inserir_antigo(antiga, keys[i], &d);
+        }
+        for (int j = 0; j < searches_per_run; j++)
+            queries[j] = keys[rand_grande() % n];
+
+        double tempo_antigo[NUM_REPETITIONS], tempo_novo[NUM_REPETITIONS];
+        long long found = 0;
+        for (int i = 0; i < NUM_REPETITIONS; i++) {
+            HighPrecisionTimer t;
+            start_timer(&t);
+            for (int j = 0; j < searches_per_run; j++)
+                found += buscar_antigo(antiga, queries[j]) != NULL;
+            tempo_antigo[i] = stop_timer(&t);
+
+            start_timer(&t);
+            for (int j = 0; j < searches_per_run; j++)
+                found += searchAVLTree(&tree, queries[j]) != NULL;
+            tempo_novo[i] = stop_timer(&t);
+        }
+        double media_antigo = calculate_mean(tempo_antigo, NUM_REPETITIONS);
+        double media_novo = calculate_mean(tempo_novo, NUM_REPETITIONS);
+        printf("  Tamanho: %6d | Antigo: %7.2f Mbuscas/s | Atual: %7.2f Mbuscas/s | Ganho: %.2fx (%lld achadas)\n",
+               n, searches_per_run / (media_antigo * 1000.0), searches_per_run / (media_novo * 1000.0),
+               media_antigo / media_novo, found);
+
+        liberar_antigo(antiga);
+        freeAVLTree(&tree);
+    }
+    free(keys);
+    free(queries);
+}
+
+// ================= AVL x ARVORE B+ (COMPARACAO) =================
+
+// Chave da arvore B+ (arvore_bmais.h) para um int, na mesma ordem
+uint64_t bplus_key(int key) {
+    return (uint64_t)((int64_t)key - INT32_MIN);
+}
+
+// Posiciona o cursor no primeiro no com chave >= key e o devolve (NULL se
+// nao houver): a descida empilha os nos onde vai a esquerda, como faria o
+// percurso em ordem ate ali
+AVLNode* seek_node(CursorArvore* it, const AVLTree* tree, int key) {
+    cursor_iniciar(it, tree->nos.itens, sizeof(AVLNode), offsetof(AVLNode, left), offsetof(AVLNode, right));
+    uint32_t node = tree->root;
+    while (node) {
+        AVLNode* n = no_avl(tree, node);
+        if (key <= n->key) {
+            cursor_empilhar(it, node);
+            node = n->left;
+        } else {
+            node = n->right;
+        }
+    }
+    return proximo_no(it);
+}
+
+// Tempos de uma estrutura numa rodada da comparacao
+typedef struct IndexTimes {
+    double insert, search, scan, ranges, remove;
+    int height;
+    size_t memory;
+    long long check; // Buscas achadas + soma das chaves lidas: igual em todas as estruturas
+} IndexTimes;
+
+void print_index_times(const char* name, const IndexTimes* r, int repetitions, int searches_per_run) {
+    IndexTimes m = {0};
+    for (int i = 0; i < repetitions; i++) {
+        m.insert += r[i].insert / repetitions;
+        m.search += r[i].search / repetitions;
+        m.scan += r[i].scan / repetitions;
+        m.ranges += r[i].ranges / repetitions;
+        m.remove += r[i].remove / repetitions;
+    }
+    printf("  %-18s | %9.2f | %9.2f | %9.2f | %10.2f | %9.2f | %6d | %8zu | %lld\n", name, m.insert,
+           searches_per_run / (m.search * 1000.0), m.scan, m.ranges, m.remove, r[0].height, r[0].memory / 1024, r[0].check);
+}
+
+// Mesmas chaves (unicas, em ordem aleatoria), mesmas buscas e mesmos
+// intervalos na AVLTree e em arvores B+ com nos de uma a 64 linhas de cache;
+// as duas guardam as transacoes num deposito a parte e indexam o indice dela
+void benchmark_bplus_vs_avl() {
+    printf("\nBenchmark AVL x Arvore B+ (tempos em ms; busca em Mbuscas/s; memoria dos nos em uso, em KB):\n");
+    int sizes[] = {100000, 1000000};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    size_t node_bytes[] = {128, 256, 512, 1024, 4096};
+    int num_node_sizes = sizeof(node_bytes) / sizeof(node_bytes[0]);
+    const int repetitions = 3; // Cada repeticao monta tudo de novo; com 1M de chaves, 10 seria lento demais
+    const int searches_per_run = 1000000;
+    const int ranges_per_run = 10000;
+    const int range_length = 100;
+
+    int* keys = (int*)malloc(sizes[num_sizes - 1] * sizeof(int));
+    int* queries = (int*)malloc(searches_per_run * sizeof(int));
+    IndexTimes* r = (IndexTimes*)malloc(repetitions * sizeof(IndexTimes));
+    if (!keys || !queries || !r) {
+        perror("Erro ao alocar dados da comparacao com a arvore B+");
+        free(keys);
+        free(queries);
+        free(r);
+        return;
+    }
+    Transaction d = {0};
+    snprintf(d.transaction_id, sizeof(d.transaction_id), "TRN%08d", 0);
+    d.amount = 10.0f;
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        for (int i = 0; i < n; i++) keys[i] = i * 8 + rand() % 8;
+        for (int i = n - 1; i > 0; i--) {
+            int j = rand_grande() % (i + 1);
+            int tmp = keys[i];
+            keys[i] = keys[j];
+            keys[j] = tmp;
+        }
+        for (int j = 0; j < searches_per_run; j++) queries[j] = keys[rand_grande() % n];
+
+        printf("\n  %d chaves:\n", n);
+        printf("  %-18s | %9s | %9s | %9s | %10s | %9s | %6s | %8s | %s\n", "Estrutura", "Insercao", "Busca",
+               "Varredura", "Intervalos", "Remocao", "Altura", "Memoria", "Verificacao");
+
+        for (int rep = 0; rep < repetitions; rep++) {
+            HighPrecisionTimer t;
+            AVLTree tree;
+            CursorArvore it;
+            long long check = 0;
+            initAVLTree(&tree);
+
+            start_timer(&t);
+            for (int i = 0; i < n; i++) insertAVLTree(&tree, keys[i], d);
+            r[rep].insert = stop_timer(&t);
+
+            start_timer(&t);
+            for (int j = 0; j < searches_per_run; j++) check += searchAVLTree(&tree, queries[j]) != NULL;
+            r[rep].search = stop_timer(&t);
+
+            start_timer(&t);
+            for (AVLNode* node = primeiro_no(&it, &tree); node; node = proximo_no(&it)) check += node->key;
+            r[rep].scan = stop_timer(&t);
+
+            start_timer(&t);
+            for (int j = 0; j < ranges_per_run; j++) {
+                AVLNode* node = seek_node(&it, &tree, queries[j]);
+                for (int k = 0; k < range_length && node; k++, node = proximo_no(&it)) check += node->key;
+            }
+            r[rep].ranges = stop_timer(&t);
+
+            r[rep].height = height(&tree, tree.root);
+            r[rep].memory = (size_t)tree.nos.vivos * sizeof(AVLNode);
+            start_timer(&t);
+            for (int i = 0; i < n; i++) deleteAVLTree(&tree, keys[i]);
+            r[rep].remove = stop_timer(&t);
+            r[rep].check = check;
+            freeAVLTree(&tree);
+        }
+        print_index_times("AVL", r, repetitions, searches_per_run);
+
+        for (int b = 0; b < num_node_sizes; b++) {
+            uint32_t capacity = 0;
+            for (int rep = 0; rep < repetitions; rep++) {
+                HighPrecisionTimer t;
+                ArvoreBMais tree;
+                PoolIndices records;
+                CursorBMais c;
+                uint64_t key;
+                uint32_t record;
+                long long check = 0;
+                bmais_iniciar(&tree, node_bytes[b]);
+                pool_iniciar(&records, sizeof(Transaction));
+                capacity = tree.capacidade;
+
+                start_timer(&t);
+                for (int i = 0; i < n; i++) {
+                    record = pool_alocar(&records);
+                    *(Transaction*)pool_item(&records, record) = d;
+                    bmais_inserir(&tree, bplus_key(keys[i]), record);
+                }
+                r[rep].insert = stop_timer(&t);
+
+                start_timer(&t);
+                for (int j = 0; j < searches_per_run; j++) check += bmais_buscar(&tree, bplus_key(queries[j]), &record);
+                r[rep].search = stop_timer(&t);
+
+                start_timer(&t);
+                bmais_primeiro(&c, &tree);
+                while (bmais_proximo(&c, &key, NULL)) check += (int)((int64_t)key + INT32_MIN);
+                r[rep].scan = stop_timer(&t);
+
+                start_timer(&t);
+                for (int j = 0; j < ranges_per_run; j++) {
+                    bmais_cursor_desde(&c, &tree, bplus_key(queries[j]), 0);
+                    for (int k = 0; k < range_length && bmais_proximo(&c, &key, NULL); k++)
+                        check += (int)((int64_t)key + INT32_MIN);
+                }
+                r[rep].ranges = stop_timer(&t);
+
+                r[rep].height = (int)tree.altura;
+                r[rep].memory = (size_t)tree.nos.vivos * tree.nos.tamanho_item;
+                // A remocao precisa do par inteiro: uma busca pelo indice da transacao e a remocao
+                start_timer(&t);
+                for (int i = 0; i < n; i++) {
+                    if (bmais_buscar(&tree, bplus_key(keys[i]), &record)) {
+                        bmais_remover(&tree, bplus_key(keys[i]), record);
+                        pool_devolver(&records, record);
+                    }
+                }
+                r[rep].remove = stop_timer(&t);
+                r[rep].check = check;
+                bmais_liberar(&tree);
+                pool_liberar(&records);
+            }
+            char name[32];
+            snprintf(name, sizeof(name), "B+ %zu B (%u/no)", node_bytes[b], (unsigned)capacity);
+            print_index_times(name, r, repetitions, searches_per_run);
+        }
+    }
+    free(keys);
+    free(queries);
+    free(r);
+}
+
 // Realiza o benchmark de acesso aleatorio
 void benchmark_random_access(AVLTree* tree) {
     if (tree->size == 0) {
@@ -571,14 +1057,8 @@ void benchmark_random_access(AVLTree* tree) {
     printf("\nBenchmark Acesso Aleatorio (%d acessos):\n", 10000); // 10000 acessos por repeticao
 
     // Encontra o menor e maior UDI para o intervalo de acesso (fora do loop de repeticoes)
-    AVLNode* minNode = tree->root;
-    while (minNode != NULL && minNode->left != NULL) {
-        minNode = minNode->left;
-    }
-    AVLNode* maxNode = tree->root;
-    while (maxNode != NULL && maxNode->right != NULL) {
-        maxNode = maxNode->right;
-    }
+    AVLNode* minNode = min_node(tree);
+    AVLNode* maxNode = max_node(tree);
     
     int minUDI = minNode ? minNode->key : 0; 
     int maxUDI = maxNode ? maxNode->key : 0; 
@@ -634,7 +1114,7 @@ void benchmark_scalability() {
             start_timer(&t);
             generateRandomData(&tree, current_size);
             results[i] = stop_timer(&t);
-            freeAVLTree(tree.root);
+            freeAVLTree(&tree);
         }
         double mean = calculate_mean(results, NUM_REPETITIONS);
         double std_dev = calculate_std_dev(results, NUM_REPETITIONS, mean);
@@ -656,36 +1136,12 @@ void benchmark_combined_operations(AVLTree* tree) {
         
         // Crie uma copia da arvore para cada repeticao para garantir o estado inicial
         AVLTree tmp_tree_for_ops;
-        initAVLTree(&tmp_tree_for_ops);
-        // Travessia em ordem para popular tmp_tree_for_ops
-        AVLNode** stack = (AVLNode**)malloc((tree->size + 1) * sizeof(AVLNode*)); 
-        if (!stack) {
-            perror("Erro ao alocar stack para travessia em ops combinadas");
-            return;
-        }
-        int top = -1;
-        AVLNode* current_original = tree->root;
-        while (current_original != NULL || top != -1) {
-            while (current_original != NULL) {
-                stack[++top] = current_original;
-                current_original = current_original->left;
-            }
-            current_original = stack[top--];
-            insertAVLTree(&tmp_tree_for_ops, current_original->key, current_original->data);
-            current_original = current_original->right;
-        }
-        free(stack);
+        cloneAVLTree(&tmp_tree_for_ops, tree);
 
 
         // Encontra o menor e maior UDI para o intervalo de operacoes
-        AVLNode* minNode = tmp_tree_for_ops.root;
-        while (minNode != NULL && minNode->left != NULL) {
-            minNode = minNode->left;
-        }
-        AVLNode* maxNode = tmp_tree_for_ops.root;
-        while (maxNode != NULL && maxNode->right != NULL) {
-            maxNode = maxNode->right;
-        }
+        AVLNode* minNode = min_node(&tmp_tree_for_ops);
+        AVLNode* maxNode = max_node(&tmp_tree_for_ops);
         
         int minUDI = minNode ? minNode->key : 0; 
         int maxUDI = maxNode ? maxNode->key : 0; 
@@ -721,7 +1177,7 @@ void benchmark_combined_operations(AVLTree* tree) {
             }
         }
         results[i] = stop_timer(&t);
-        freeAVLTree(tmp_tree_for_ops.root); 
+        freeAVLTree(&tmp_tree_for_ops); 
     }
 
     double mean = calculate_mean(results, NUM_REPETITIONS);
@@ -739,7 +1195,7 @@ void run_all_benchmarks(AVLTree* tree) {
     printf("===========================================\n");
 
     // Limpa a arvore de benchmark antes de iniciar os testes
-    freeAVLTree(tree->root);
+    freeAVLTree(tree);
     initAVLTree(tree);
 
     HighPrecisionTimer t_total;
@@ -753,6 +1209,8 @@ void run_all_benchmarks(AVLTree* tree) {
     printf("\n1. Tempo de Insercao:\n"); 
     benchmark_insertion(tree, 1000);
     benchmark_insertion(tree, 10000);
+    benchmark_bulk_load(10000);
+    benchmark_bulk_load(100000);
 
     printf("\n2. Tempo de Remocao:\n"); 
     benchmark_removal(tree);
@@ -772,6 +1230,12 @@ void run_all_benchmarks(AVLTree* tree) {
     printf("\n7. Latencia Media (operacoes combinadas):\n"); 
     benchmark_combined_operations(tree);
 
+    printf("\n8. Layout do No:\n"); 
+    benchmark_node_layout();
+
+    printf("\n9. AVL x Arvore B+:\n");
+    benchmark_bplus_vs_avl();
+
     double elapsed_total = stop_timer(&t_total);
     printf("\nTempo TOTAL da suite de benchmarks completa: %.3f ms\n", elapsed_total);
 
@@ -782,15 +1246,10 @@ void run_all_benchmarks(AVLTree* tree) {
 
 // Funcao para remover o primeiro elemento (para restricao R2)
 void removeFirst(AVLTree* tree) {
-    if (tree == NULL || tree->root == NULL) return;
+    if (tree == NULL || tree->root == 0) return;
     
     // Encontra o no com o menor UDI (mais a esquerda)
-    AVLNode* current = tree->root;
-    while (current->left != NULL) {
-        current = current->left;
-    }
-    
-    deleteAVLTree(tree, current->key);
+    deleteAVLTree(tree, min_node(tree)->key);
 }
 
 // Gera dados, incluindo anomalias e aplicando restricoes de tempo/tamanho
@@ -866,7 +1325,7 @@ void run_restricted_benchmarks() {
     benchmark_random_access(&tree);
     estimate_memory_usage(&tree);
 
-    freeAVLTree(tree.root);
+    freeAVLTree(&tree);
 
     printf("\n==============================================\n");
     printf("=== FIM DOS TESTES COM RESTRICOES ===\n"); 
@@ -915,7 +1374,7 @@ int main() {
 
 
     // Libera a arvore AVL principal de benchmark se ela ainda contiver dados
-    freeAVLTree(benchmark_avl_tree.root);
+    freeAVLTree(&benchmark_avl_tree);
 
     return 0;
 }
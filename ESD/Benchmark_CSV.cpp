@@ -0,0 +1,281 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <stdint.h>
+#include <string>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h> // Necessario para HighPrecisionTimer
+#include "leitor_csv.h"
+
+#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#define NUM_REPETITIONS 10 // Numero de repeticoes para cada benchmark individual
+
+// ================= ESTRUTURAS DE DADOS =================
+
+// Campos numericos extraidos do dataset (apontam para o arquivo mapeado)
+typedef struct ColunasNumericas {
+    CampoCSV* amount;
+    CampoCSV* is_fraud;
+    size_t quantidade;
+    size_t bytes_amount;
+    size_t bytes_fraude;
+} ColunasNumericas;
+
+// Evita que o compilador descarte as conversoes medidas
+static volatile double sumidouro;
+
+// ================= FUNCOES AUXILIARES PARA ESTATISTICAS =================
+
+// Calcula a media de um array de doubles
+double calculate_mean(double* data, int count) {
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += data[i];
+    }
+    return sum / count;
+}
+
+// Calcula o desvio padrao de um array de doubles
+double calculate_std_dev(double* data, int count, double mean) {
+    double sum_sq_diff = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum_sq_diff += pow(data[i] - mean, 2);
+    }
+    return sqrt(sum_sq_diff / count);
+}
+
+// Calcula o coeficiente de variacao
+double calculate_coeff_of_variation(double mean, double std_dev) {
+    if (mean == 0) return 0.0; // Evita divisao por zero
+    return (std_dev / mean) * 100.0; // Em porcentagem
+}
+
+// ================= FUNCOES DE BENCHMARK =================
+
+// Estrutura para timer de alta precisao (Windows specific)
+typedef struct {
+    LARGE_INTEGER start;
+    LARGE_INTEGER end;
+    LARGE_INTEGER frequency;
+} HighPrecisionTimer;
+
+// Inicia o timer
+void start_timer(HighPrecisionTimer* timer) {
+    QueryPerformanceFrequency(&timer->frequency);
+    QueryPerformanceCounter(&timer->start);
+}
+
+// Para o timer e retorna o tempo decorrido em milissegundos
+double stop_timer(HighPrecisionTimer* timer) {
+    QueryPerformanceCounter(&timer->end);
+    double elapsed = (double)(timer->end.QuadPart - timer->start.QuadPart) * 1000.0 / timer->frequency.QuadPart;
+    return elapsed;
+}
+
+// Le o dataset e guarda so as colunas amount e is_fraud de cada linha valida
+bool carregar_colunas(LeitorCSV* leitor, const char* caminho, ColunasNumericas* colunas) {
+    memset(colunas, 0, sizeof(*colunas));
+    if (!csv_abrir(leitor, caminho)) return false;
+
+    size_t capacidade = 1024;
+    colunas->amount = (CampoCSV*)malloc(capacidade * sizeof(CampoCSV));
+    colunas->is_fraud = (CampoCSV*)malloc(capacidade * sizeof(CampoCSV));
+
+    LinhaCSV linha;
+    while (csv_proxima_linha(leitor, &linha)) {
+        if (!csv_linha_completa(&linha)) continue;
+        if (colunas->quantidade == capacidade) {
+            capacidade *= 2;
+            colunas->amount = (CampoCSV*)realloc(colunas->amount, capacidade * sizeof(CampoCSV));
+            colunas->is_fraud = (CampoCSV*)realloc(colunas->is_fraud, capacidade * sizeof(CampoCSV));
+        }
+        colunas->amount[colunas->quantidade] = linha.campos[CAMPO_AMOUNT];
+        colunas->is_fraud[colunas->quantidade] = linha.campos[CAMPO_FRAUDE];
+        colunas->bytes_amount += linha.campos[CAMPO_AMOUNT].tamanho;
+        colunas->bytes_fraude += linha.campos[CAMPO_FRAUDE].tamanho;
+        colunas->quantidade++;
+    }
+    return true;
+}
+
+// ---- Conversores de amount comparados ----
+
+// Caminho antigo dos loaders: sscanf com %f sobre o texto do campo
+double somar_amount_sscanf(const ColunasNumericas* c) {
+    double soma = 0.0;
+    char buffer[64];
+    for (size_t i = 0; i < c->quantidade; i++) {
+        float valor = 0.0f;
+        CSV_COPIAR(buffer, c->amount[i]);
+        sscanf(buffer, "%f", &valor);
+        soma += valor;
+    }
+    return soma;
+}
+
+// Caminho antigo do Cuckoo Hashing: std::stof sobre uma std::string
+double somar_amount_stof(const ColunasNumericas* c) {
+    double soma = 0.0;
+    for (size_t i = 0; i < c->quantidade; i++) {
+        std::string texto(c->amount[i].inicio, c->amount[i].tamanho);
+        soma += std::stof(texto);
+    }
+    return soma;
+}
+
+double somar_amount_strtof(const ColunasNumericas* c) {
+    double soma = 0.0;
+    for (size_t i = 0; i < c->quantidade; i++)
+        soma += csv_campo_float_strtof(c->amount[i]);
+    return soma;
+}
+
+double somar_amount_rapido(const ColunasNumericas* c) {
+    double soma = 0.0;
+    for (size_t i = 0; i < c->quantidade; i++)
+        soma += csv_campo_float(c->amount[i]);
+    return soma;
+}
+
+// ---- Decodificadores de is_fraud comparados ----
+
+double contar_fraude_strcmp(const ColunasNumericas* c) {
+    size_t fraudes = 0;
+    char buffer[8];
+    for (size_t i = 0; i < c->quantidade; i++) {
+        CSV_COPIAR(buffer, c->is_fraud[i]);
+        fraudes += strcmp(buffer, "True") == 0;
+    }
+    return (double)fraudes;
+}
+
+double contar_fraude_rapido(const ColunasNumericas* c) {
+    size_t fraudes = 0;
+    for (size_t i = 0; i < c->quantidade; i++)
+        fraudes += csv_campo_fraude(c->is_fraud[i]);
+    return (double)fraudes;
+}
+
+typedef double (*ConversorColuna)(const ColunasNumericas* c);
+
+// Executa um conversor NUM_REPETITIONS vezes e imprime tempo e vazao
+void benchmark_conversor(const char* nome, ConversorColuna conversor,
+                         const ColunasNumericas* colunas, size_t bytes) {
+    double results[NUM_REPETITIONS];
+    double resultado = 0.0;
+
+    for (int i = 0; i < NUM_REPETITIONS; i++) {
+        HighPrecisionTimer t;
+        start_timer(&t);
+        resultado = conversor(colunas);
+        results[i] = stop_timer(&t);
+    }
+    sumidouro = resultado;
+
+    double mean = calculate_mean(results, NUM_REPETITIONS);
+    double std_dev = calculate_std_dev(results, NUM_REPETITIONS, mean);
+    double cov = calculate_coeff_of_variation(mean, std_dev);
+    double ns_campo = mean * 1e6 / (double)colunas->quantidade;
+    double mb_s = mean > 0 ? (bytes / (1024.0 * 1024.0)) / (mean / 1000.0) : 0.0;
+
+    printf("  %-10s | Media: %8.3f ms | DP: %7.3f ms | CV: %5.2f%% | %6.2f ns/campo | %8.1f MB/s | resultado: %.2f\n",
+           nome, mean, std_dev, cov, ns_campo, mb_s, resultado);
+}
+
+// Confere campo a campo se o caminho rapido devolve exatamente o mesmo valor
+void validar_conversores(const ColunasNumericas* c) {
+    size_t divergencias_amount = 0, divergencias_fraude = 0;
+    char buffer[8];
+    for (size_t i = 0; i < c->quantidade; i++) {
+        float esperado = csv_campo_float_strtof(c->amount[i]);
+        float obtido = csv_campo_float(c->amount[i]);
+        if (memcmp(&esperado, &obtido, sizeof(float)) != 0) {
+            if (divergencias_amount < 5)
+                printf("  Divergencia amount: %.*s -> %.9g (esperado %.9g)\n",
+                       (int)c->amount[i].tamanho, c->amount[i].inicio, obtido, esperado);
+            divergencias_amount++;
+        }
+        CSV_COPIAR(buffer, c->is_fraud[i]);
+        if ((strcmp(buffer, "True") == 0) != csv_campo_fraude(c->is_fraud[i]))
+            divergencias_fraude++;
+    }
+    printf("  Divergencias amount: %zu | Divergencias is_fraud: %zu\n",
+           divergencias_amount, divergencias_fraude);
+}
+
+void run_all_benchmarks(const char* caminho) {
+    printf("\n===========================================\n");
+    printf("=== BENCHMARK DE CONVERSAO DE COLUNAS CSV ===\n");
+    printf("===========================================\n");
+
+    LeitorCSV leitor;
+    ColunasNumericas colunas;
+    if (!carregar_colunas(&leitor, caminho, &colunas)) {
+        perror("Erro ao abrir o arquivo");
+        return;
+    }
+    printf("Linhas validas: %zu\n", colunas.quantidade);
+
+    if (colunas.quantidade > 0) {
+        printf("\n1. Validacao (caminho rapido x strtof/strcmp):\n");
+        validar_conversores(&colunas);
+
+        printf("\n2. Coluna amount (%zu campos):\n", colunas.quantidade);
+        benchmark_conversor("sscanf", somar_amount_sscanf, &colunas, colunas.bytes_amount);
+        benchmark_conversor("stof", somar_amount_stof, &colunas, colunas.bytes_amount);
+        benchmark_conversor("strtof", somar_amount_strtof, &colunas, colunas.bytes_amount);
+        benchmark_conversor("rapido", somar_amount_rapido, &colunas, colunas.bytes_amount);
+
+        printf("\n3. Coluna is_fraud (%zu campos):\n", colunas.quantidade);
+        benchmark_conversor("strcmp", contar_fraude_strcmp, &colunas, colunas.bytes_fraude);
+        benchmark_conversor("rapido", contar_fraude_rapido, &colunas, colunas.bytes_fraude);
+    }
+
+    free(colunas.amount);
+    free(colunas.is_fraud);
+    csv_fechar(&leitor);
+
+    printf("\n===========================================\n");
+    printf("=== BENCHMARKS CONCLUIDOS ===\n");
+    printf("===========================================\n");
+}
+
+// ================= MAIN FUNCTION (BENCHMARK ONLY) =================
+
+int main() {
+    const char* caminho = "C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv";
+    int choice;
+
+    do {
+        printf("\n--- Opcoes de Benchmark (Conversao CSV) ---\n");
+        printf("1. Rodar Benchmarks de amount/is_fraud\n");
+        printf("2. Sair\n");
+        printf("Escolha uma opcao: ");
+        if (scanf("%d", &choice) != 1) choice = 2;
+
+        // Limpa o buffer de entrada
+        int c;
+        while ((c = getchar()) != '\n' && c != EOF);
+
+        switch (choice) {
+            case 1:
+                run_all_benchmarks(caminho);
+                break;
+            case 2:
+                printf("Saindo do programa de benchmark.\n");
+                break;
+            default:
+                printf("Opcao invalida. Por favor, tente novamente.\n");
+                break;
+        }
+    } while (choice != 2);
+
+    return 0;
+}
@@ -0,0 +1,265 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <stdint.h>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h> // Necessario para HighPrecisionTimer
+#include "leitor_csv.h"
+#include "hash_rapido.h"
+#include "codec_id.h"
+
+#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#define NUM_REPETITIONS 10 // Numero de repeticoes para cada benchmark individual
+#define PRIMO_ANTIGO 10007 // Tamanho primo usado pelas tabelas antigas com modulo
+#define IDS_SINTETICOS 1000000
+
+// ================= ESTRUTURAS DE DADOS =================
+
+// IDs no mesmo formato dos structs: buffer fixo de 16 bytes
+typedef struct ConjuntoIDs {
+    char (*ids)[16];
+    size_t quantidade;
+} ConjuntoIDs;
+
+// Funcao de hash avaliada no benchmark
+typedef struct FuncaoAvaliada {
+    const char* nome;
+    FuncaoHash funcao;
+} FuncaoAvaliada;
+
+// Caminho das tabelas: codifica o ID em inteiro e hasheia a chave
+static uint64_t hash_codec(const char* id) {
+    return codec_id_hash(codec_id_codificar(id), 0);
+}
+
+static const FuncaoAvaliada FUNCOES[] = {
+    {"djb2", hash_djb2},
+    {"fnv1a", hash_fnv1a},
+    {"texto", hash_texto},
+    {"id16", hash_id16},
+    {"codec", hash_codec},
+};
+#define NUM_FUNCOES (int)(sizeof(FUNCOES) / sizeof(FUNCOES[0]))
+
+// Evita que o compilador descarte os hashes medidos
+static volatile uint64_t sumidouro;
+
+// ================= FUNCOES AUXILIARES PARA ESTATISTICAS =================
+
+// Calcula a media de um array de doubles
+double calculate_mean(double* data, int count) {
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += data[i];
+    }
+    return sum / count;
+}
+
+// Calcula o desvio padrao de um array de doubles
+double calculate_std_dev(double* data, int count, double mean) {
+    double sum_sq_diff = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum_sq_diff += pow(data[i] - mean, 2);
+    }
+    return sqrt(sum_sq_diff / count);
+}
+
+// Calcula o coeficiente de variacao
+double calculate_coeff_of_variation(double mean, double std_dev) {
+    if (mean == 0) return 0.0; // Evita divisao por zero
+    return (std_dev / mean) * 100.0; // Em porcentagem
+}
+
+// ================= FUNCOES DE BENCHMARK =================
+
+// Estrutura para timer de alta precisao (Windows specific)
+typedef struct {
+    LARGE_INTEGER start;
+    LARGE_INTEGER end;
+    LARGE_INTEGER frequency;
+} HighPrecisionTimer;
+
+// Inicia o timer
+void start_timer(HighPrecisionTimer* timer) {
+    QueryPerformanceFrequency(&timer->frequency);
+    QueryPerformanceCounter(&timer->start);
+}
+
+// Para o timer e retorna o tempo decorrido em milissegundos
+double stop_timer(HighPrecisionTimer* timer) {
+    QueryPerformanceCounter(&timer->end);
+    double elapsed = (double)(timer->end.QuadPart - timer->start.QuadPart) * 1000.0 / timer->frequency.QuadPart;
+    return elapsed;
+}
+
+// Le os transaction_id do dataset; sem o arquivo, gera IDs no formato TRN
+bool carregar_ids(const char* caminho, ConjuntoIDs* conjunto) {
+    size_t capacidade = 1024;
+    conjunto->quantidade = 0;
+    conjunto->ids = (char (*)[16])malloc(capacidade * 16);
+    if (!conjunto->ids) return false;
+
+    LeitorCSV leitor;
+    if (csv_abrir(&leitor, caminho)) {
+        LinhaCSV linha;
+        while (csv_proxima_linha(&leitor, &linha)) {
+            if (linha.num_campos == 0 || linha.campos[CAMPO_ID].tamanho == 0) continue;
+            if (conjunto->quantidade == capacidade) {
+                capacidade *= 2;
+                conjunto->ids = (char (*)[16])realloc(conjunto->ids, capacidade * 16);
+                if (!conjunto->ids) return false;
+            }
+            memset(conjunto->ids[conjunto->quantidade], 0, 16);
+            CSV_COPIAR(conjunto->ids[conjunto->quantidade], linha.campos[CAMPO_ID]);
+            conjunto->quantidade++;
+        }
+        csv_fechar(&leitor);
+        printf("IDs lidos do dataset: %zu\n", conjunto->quantidade);
+        return true;
+    }
+
+    printf("Dataset nao encontrado; usando %d IDs sinteticos TRN%%08d.\n", IDS_SINTETICOS);
+    conjunto->ids = (char (*)[16])realloc(conjunto->ids, (size_t)IDS_SINTETICOS * 16);
+    if (!conjunto->ids) return false;
+    for (int i = 0; i < IDS_SINTETICOS; i++) {
+        memset(conjunto->ids[i], 0, 16);
+        snprintf(conjunto->ids[i], 16, "TRN%08d", 10000000 + i);
+    }
+    conjunto->quantidade = IDS_SINTETICOS;
+    return true;
+}
+
+// Vazao de cada funcao sobre todos os IDs
+void benchmark_vazao(const ConjuntoIDs* conjunto) {
+    printf("\nBenchmark Vazao (%zu IDs por repeticao):\n", conjunto->quantidade);
+    for (int f = 0; f < NUM_FUNCOES; f++) {
+        double results[NUM_REPETITIONS];
+        uint64_t acumulado = 0;
+        for (int i = 0; i < NUM_REPETITIONS; i++) {
+            HighPrecisionTimer t;
+            start_timer(&t);
+            for (size_t j = 0; j < conjunto->quantidade; j++)
+                acumulado += FUNCOES[f].funcao(conjunto->ids[j]);
+            results[i] = stop_timer(&t);
+        }
+        sumidouro = acumulado;
+
+        double mean = calculate_mean(results, NUM_REPETITIONS);
+        double std_dev = calculate_std_dev(results, NUM_REPETITIONS, mean);
+        double cov = calculate_coeff_of_variation(mean, std_dev);
+        printf("  %-6s | Media: %8.3f ms | DP: %7.3f ms | CV: %5.2f%% | %6.2f ns/ID | %7.1f M IDs/s\n",
+               FUNCOES[f].nome, mean, std_dev, cov, mean * 1e6 / conjunto->quantidade,
+               mean > 0 ? conjunto->quantidade / (mean * 1000.0) : 0.0);
+    }
+}
+
+// Distribuicao dos IDs em "num_baldes" baldes. A qualidade compara o custo
+// esperado de busca (soma de c*(c+1)/2) com o de um hash aleatorio ideal:
+// 1.00 e ideal, valores bem acima indicam agrupamento.
+void avaliar_distribuicao(const char* rotulo, const ConjuntoIDs* conjunto, FuncaoHash funcao,
+                          size_t num_baldes, bool usar_mascara) {
+    uint32_t* baldes = (uint32_t*)calloc(num_baldes, sizeof(uint32_t));
+    if (!baldes) {
+        perror("Falha ao alocar memoria para os baldes");
+        return;
+    }
+    for (size_t j = 0; j < conjunto->quantidade; j++) {
+        uint64_t h = funcao(conjunto->ids[j]);
+        size_t indice = usar_mascara ? hash_balde(h, num_baldes) : (size_t)(h % num_baldes);
+        baldes[indice]++;
+    }
+
+    size_t vazios = 0;
+    uint32_t maior = 0;
+    double soma = 0.0;
+    for (size_t i = 0; i < num_baldes; i++) {
+        if (baldes[i] == 0) vazios++;
+        if (baldes[i] > maior) maior = baldes[i];
+        soma += (double)baldes[i] * (baldes[i] + 1) / 2.0;
+    }
+    double n = (double)conjunto->quantidade, m = (double)num_baldes;
+    double esperado = (n / (2.0 * m)) * (n + 2.0 * m - 1.0);
+
+    printf("  %-22s | baldes: %8zu | vazios: %6.2f%% | maior cadeia: %5u | qualidade: %.3f\n",
+           rotulo, num_baldes, vazios * 100.0 / num_baldes, maior, esperado > 0 ? soma / esperado : 0.0);
+    free(baldes);
+}
+
+void benchmark_distribuicao(const ConjuntoIDs* conjunto) {
+    // Potencia de 2 com fator de carga entre 0.5 e 1, como a Hash table3
+    size_t potencia = 16;
+    while (potencia < conjunto->quantidade) potencia <<= 1;
+
+    printf("\nBenchmark Distribuicao (%zu IDs):\n", conjunto->quantidade);
+    char rotulo[64];
+    for (int f = 0; f < NUM_FUNCOES; f++) {
+        snprintf(rotulo, sizeof(rotulo), "%s %% %d", FUNCOES[f].nome, PRIMO_ANTIGO);
+        avaliar_distribuicao(rotulo, conjunto, FUNCOES[f].funcao, PRIMO_ANTIGO, false);
+        snprintf(rotulo, sizeof(rotulo), "%s & (2^k - 1)", FUNCOES[f].nome);
+        avaliar_distribuicao(rotulo, conjunto, FUNCOES[f].funcao, potencia, true);
+    }
+}
+
+void run_all_benchmarks(const char* caminho) {
+    printf("\n===========================================\n");
+    printf("=== BENCHMARK DE FUNCOES DE HASH ===\n");
+    printf("===========================================\n");
+
+    ConjuntoIDs conjunto;
+    if (!carregar_ids(caminho, &conjunto)) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        return;
+    }
+
+    if (conjunto.quantidade > 0) {
+        printf("\n1. Vazao:\n");
+        benchmark_vazao(&conjunto);
+        printf("\n2. Qualidade da distribuicao:\n");
+        benchmark_distribuicao(&conjunto);
+    }
+    free(conjunto.ids);
+
+    printf("\n===========================================\n");
+    printf("=== BENCHMARKS CONCLUIDOS ===\n");
+    printf("===========================================\n");
+}
+
+// ================= MAIN FUNCTION (BENCHMARK ONLY) =================
+
+int main() {
+    const char* caminho = "C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv";
+    int choice;
+
+    do {
+        printf("\n--- Opcoes de Benchmark (Funcoes de Hash) ---\n");
+        printf("1. Rodar Benchmarks de vazao e distribuicao\n");
+        printf("2. Sair\n");
+        printf("Escolha uma opcao: ");
+        if (scanf("%d", &choice) != 1) choice = 2;
+
+        // Limpa o buffer de entrada
+        int c;
+        while ((c = getchar()) != '\n' && c != EOF);
+
+        switch (choice) {
+            case 1:
+                run_all_benchmarks(caminho);
+                break;
+            case 2:
+                printf("Saindo do programa de benchmark.\n");
+                break;
+            default:
+                printf("Opcao invalida. Por favor, tente novamente.\n");
+                break;
+        }
+    } while (choice != 2);
+
+    return 0;
+}
@@ -6,10 +6,20 @@
 #include <map>
 #include <vector>
 #include <algorithm>
+#include "leitor_csv.h"
+#include "snapshot_fdb.h"
+#include "hash_rapido.h"
+#include "codec_id.h"
 using namespace std;
 
-const int TABLE_SIZE = 10000019;
-const int MAX_RELOCATIONS = 500;
+const int SLOTS_POR_BALDE = 4;
+const unsigned int BALDES_MINIMOS = 1 << 10;  // Potencia de 2; a tabela cresce conforme os dados
+const double CARGA_INICIAL = 0.75;            // Carga prevista ao dimensionar pela estimativa de linhas
+const int MAX_BFS = 256;                      // Baldes visitados por insercao, limita a latencia
+const double CARGA_MAXIMA = 0.95;             // Acima disso a tabela dobra
+const double CARGA_DOBRAR = 0.85;             // Reserva cheia abaixo disso: so troca as sementes
+const size_t LIMITE_RESERVA = 16;             // Registros na reserva antes de um rehash
+const unsigned int BALDES_POR_PASSO = 8;      // Baldes migrados a cada operacao durante um rehash
 //Estrutura da Cuckoo Hashing
 struct Transaction {
     char transaction_id[50];
@@ -21,105 +31,357 @@ struct Transaction {
     char merchant_category[50];
     char location[50];
     char device_used[50];
+    uint64_t chave; // transaction_id codificado (codec_id.h), preenchido em insert
 };
 
-Transaction* table1[TABLE_SIZE];
-Transaction* table2[TABLE_SIZE];
+// Baldes de 4 slots de uma geracao da tabela. Uma impressao de 8 bits por
+// slot (0 = vazio) fica num array compacto separado, entao a busca so segue o
+// ponteiro do registro quando a impressao bate.
+struct ArranjoCuckoo {
+    uint8_t (*impressoes)[SLOTS_POR_BALDE]; // NULL quando o arranjo nao existe
+    Transaction* (*slots)[SLOTS_POR_BALDE];
+    unsigned int num_baldes;
+    uint64_t semente;                       // Baldes da chave: sementes "semente" e "semente + 1"
+};
+
+// Cada chave tem dois baldes candidatos no arranjo atual. Se a busca em largura
+// por deslocamentos nao achar vaga, o registro vai para a reserva (stash),
+// consultada por ultimo: nada e perdido. Reserva cheia ou carga alta disparam
+// um rehash incremental, como na Hash table3: o arranjo antigo continua valendo
+// para buscas e cada operacao migra alguns baldes dele para o novo.
+struct TabelaCuckoo {
+    ArranjoCuckoo atual;          // Recebe todas as insercoes
+    ArranjoCuckoo antiga;         // Sendo esvaziada durante um rehash
+    unsigned int proximo_migrar;  // Proximo balde da antiga a ser migrado
+    size_t quantidade;            // Registros nos baldes (sem contar a reserva)
+    vector<Transaction*> reserva;
+    size_t limite_reserva;        // Sobe se um rehash nao esvaziar a reserva (ex.: IDs repetidos)
+    size_t deslocamentos;         // Registros movidos por caminhos da busca em largura
+    int maior_caminho;
+    int rehashes;
+};
+
+TabelaCuckoo tabela;
+
+struct Posicao {
+    unsigned int balde1, balde2;
+    uint8_t impressao;
+};
 
-unsigned int hash1(const char* key) {
-    unsigned int hash = 0;
-    while (*key) hash = (hash * 31 + *key++) % TABLE_SIZE;
-    return hash;
+// Os dois baldes sao o mesmo hash da chave inteira com sementes diferentes;
+// relocar um elemento nao precisa reler o texto do ID
+Posicao posicao(const ArranjoCuckoo& a, uint64_t chave) {
+    uint64_t h1 = codec_id_hash(chave, a.semente);
+    Posicao p;
+    p.balde1 = (unsigned int)hash_balde(h1, a.num_baldes);
+    p.balde2 = (unsigned int)hash_balde(codec_id_hash(chave, a.semente + 1), a.num_baldes);
+    p.impressao = (uint8_t)(h1 >> 56);
+    if (p.impressao == 0) p.impressao = 1; // 0 marca slot vazio
+    return p;
 }
 
-unsigned int hash2(const char* key) {
-    unsigned int hash = 5381;
-    while (*key) hash = ((hash << 5) + hash) + *key++;
-    return hash % TABLE_SIZE;
+// calloc em vez de new[]: paginas zeradas sob demanda, entao abrir um rehash
+// nao paga a limpeza do arranjo novo inteiro de uma vez
+ArranjoCuckoo criar_arranjo(unsigned int num_baldes, uint64_t semente) {
+    ArranjoCuckoo a;
+    a.num_baldes = num_baldes;
+    a.semente = semente;
+    a.impressoes = (uint8_t (*)[SLOTS_POR_BALDE])calloc(num_baldes, sizeof(*a.impressoes));
+    a.slots = (Transaction* (*)[SLOTS_POR_BALDE])calloc(num_baldes, sizeof(*a.slots));
+    if (!a.impressoes || !a.slots) {
+        cerr << "Erro de alocacao de memoria.\n";
+        exit(1);
+    }
+    return a;
+}
+
+void liberar_arranjo(ArranjoCuckoo& a) {
+    free(a.impressoes);
+    free(a.slots);
+    a.impressoes = nullptr;
+    a.slots = nullptr;
+    a.num_baldes = 0;
+}
+
+// Menor potencia de 2 de baldes que guarda "linhas" registros com CARGA_INICIAL
+unsigned int baldes_para(size_t linhas) {
+    unsigned int baldes = BALDES_MINIMOS;
+    while (baldes < (1u << 30) && baldes * (double)SLOTS_POR_BALDE * CARGA_INICIAL < linhas) baldes <<= 1;
+    return baldes;
+}
+
+// Dimensiona pela estimativa de linhas do dataset, entao a carga inicial nao
+// passa por rehashes; se a estimativa errar, a tabela ainda cresce sozinha
+void init_tabela(size_t linhas_estimadas) {
+    tabela.atual = criar_arranjo(baldes_para(linhas_estimadas), 1);
+    tabela.antiga = ArranjoCuckoo();
+    tabela.proximo_migrar = 0;
+    tabela.quantidade = 0;
+    tabela.reserva.clear();
+    tabela.limite_reserva = LIMITE_RESERVA;
+    tabela.deslocamentos = 0;
+    tabela.maior_caminho = 0;
+    tabela.rehashes = 0;
+}
+
+// Visita todos os registros: arranjo atual, antigo (durante um rehash) e reserva
+template <typename Visitar>
+void para_cada_transacao(Visitar visitar) {
+    const ArranjoCuckoo* arranjos[2] = {&tabela.atual, &tabela.antiga};
+    for (const ArranjoCuckoo* a : arranjos)
+        for (unsigned int b = 0; b < a->num_baldes; ++b)
+            for (int s = 0; s < SLOTS_POR_BALDE; ++s)
+                if (a->impressoes[b][s]) visitar(a->slots[b][s]);
+    for (Transaction* t : tabela.reserva) visitar(t);
+}
+
+void liberar_tabela() {
+    para_cada_transacao([](Transaction* t) { delete t; });
+    liberar_arranjo(tabela.atual);
+    liberar_arranjo(tabela.antiga);
+    tabela.reserva.clear();
+}
+
+bool mesma_chave(const Transaction* t, uint64_t chave, const char* id) {
+    return codec_id_iguais(t->chave, t->transaction_id, chave, id);
+}
+
+int slot_livre(const ArranjoCuckoo& a, unsigned int balde) {
+    for (int s = 0; s < SLOTS_POR_BALDE; s++)
+        if (a.impressoes[balde][s] == 0) return s;
+    return -1;
 }
-//Inserção de transação
-bool insert(Transaction* trans) {
-    Transaction* curr = trans;
-    int count = 0;
-    while (count < MAX_RELOCATIONS) {
-        unsigned int index1 = hash1(curr->transaction_id);
-        if (table1[index1] == nullptr) {
-            table1[index1] = curr;
-            return true;
-        }
-        swap(curr, table1[index1]);
 
-        unsigned int index2 = hash2(curr->transaction_id);
-        if (table2[index2] == nullptr) {
-            table2[index2] = curr;
-            return true;
+// Slot da chave no balde, ou -1
+int procurar_no_balde(const ArranjoCuckoo& a, unsigned int balde, uint8_t impressao, uint64_t chave, const char* id) {
+    for (int s = 0; s < SLOTS_POR_BALDE; s++)
+        if (a.impressoes[balde][s] == impressao && mesma_chave(a.slots[balde][s], chave, id))
+            return s;
+    return -1;
+}
+
+// Posicao da chave na reserva, ou -1
+int procurar_na_reserva(uint64_t chave, const char* id) {
+    for (size_t i = 0; i < tabela.reserva.size(); i++)
+        if (mesma_chave(tabela.reserva[i], chave, id)) return (int)i;
+    return -1;
+}
+
+// No da busca em largura: o registro em (balde do pai, slot_pai) iria para "balde"
+struct NoBusca {
+    unsigned int balde;
+    int pai;
+    int slot_pai;
+};
+
+// Um balde so aparece uma vez no caminho, senao os movimentos se atropelam
+bool no_caminho(const NoBusca* fila, int no, unsigned int balde) {
+    for (; no >= 0; no = fila[no].pai)
+        if (fila[no].balde == balde) return true;
+    return false;
+}
+
+void mover(ArranjoCuckoo& a, unsigned int origem, int slot_origem, unsigned int destino, int slot_destino) {
+    a.slots[destino][slot_destino] = a.slots[origem][slot_origem];
+    a.impressoes[destino][slot_destino] = a.impressoes[origem][slot_origem];
+}
+
+// Procura em largura, a partir dos dois baldes cheios, o caminho mais curto de
+// deslocamentos que termina num slot livre e o executa de tras para frente.
+// Devolve o slot liberado num dos baldes da chave, ou false se passar do
+// limite (ciclo ou tabela cheia demais).
+bool abrir_espaco(ArranjoCuckoo& a, const Posicao& p, unsigned int* balde, int* slot) {
+    NoBusca fila[MAX_BFS];
+    int fim = 0;
+    fila[fim++] = {p.balde1, -1, -1};
+    if (p.balde2 != p.balde1) fila[fim++] = {p.balde2, -1, -1};
+
+    for (int atual = 0; atual < fim; atual++) {
+        unsigned int b = fila[atual].balde;
+        for (int s = 0; s < SLOTS_POR_BALDE; s++) {
+            Posicao q = posicao(a, a.slots[b][s]->chave);
+            unsigned int alternativo = q.balde1 == b ? q.balde2 : q.balde1;
+            if (alternativo == b || no_caminho(fila, atual, alternativo)) continue;
+
+            int livre = slot_livre(a, alternativo);
+            if (livre >= 0) {
+                // Cada movimento ocupa o slot que o anterior acabou de liberar
+                unsigned int destino = alternativo;
+                int slot_destino = livre, slot_origem = s, passos = 0;
+                for (int no = atual; no >= 0; no = fila[no].pai) {
+                    mover(a, fila[no].balde, slot_origem, destino, slot_destino);
+                    destino = fila[no].balde;
+                    slot_destino = slot_origem;
+                    slot_origem = fila[no].slot_pai;
+                    passos++;
+                }
+                tabela.deslocamentos += passos;
+                if (passos > tabela.maior_caminho) tabela.maior_caminho = passos;
+                *balde = destino;
+                *slot = slot_destino;
+                return true;
+            }
+            if (fim < MAX_BFS) fila[fim++] = {alternativo, atual, s};
         }
-        swap(curr, table2[index2]);
-        count++;
     }
-    cout << "Falha ao inserir: muitas relocacoes.\n";
-    delete curr;
     return false;
 }
+
+// Coloca o registro num dos seus baldes no arranjo, deslocando outros se preciso
+bool colocar(ArranjoCuckoo& a, Transaction* t) {
+    Posicao p = posicao(a, t->chave);
+    unsigned int balde = p.balde1;
+    int slot = slot_livre(a, p.balde1);
+    if (slot < 0) {
+        balde = p.balde2;
+        slot = slot_livre(a, p.balde2);
+    }
+    if (slot < 0 && !abrir_espaco(a, p, &balde, &slot)) return false;
+    a.slots[balde][slot] = t;
+    a.impressoes[balde][slot] = p.impressao;
+    return true;
+}
+
+// Move ate "limite" baldes do arranjo antigo para o atual; no fim do rehash
+// a reserva tambem tenta voltar para os baldes
+void migrar_baldes(unsigned int limite) {
+    if (!tabela.antiga.impressoes) return;
+    while (limite-- > 0 && tabela.proximo_migrar < tabela.antiga.num_baldes) {
+        unsigned int b = tabela.proximo_migrar++;
+        for (int s = 0; s < SLOTS_POR_BALDE; s++) {
+            if (!tabela.antiga.impressoes[b][s]) continue;
+            Transaction* t = tabela.antiga.slots[b][s];
+            tabela.antiga.impressoes[b][s] = 0;
+            if (!colocar(tabela.atual, t)) {
+                tabela.quantidade--;
+                tabela.reserva.push_back(t);
+            }
+        }
+    }
+    if (tabela.proximo_migrar < tabela.antiga.num_baldes) return;
+
+    liberar_arranjo(tabela.antiga);
+    tabela.proximo_migrar = 0;
+    vector<Transaction*> pendentes;
+    pendentes.swap(tabela.reserva);
+    for (Transaction* t : pendentes) {
+        if (colocar(tabela.atual, t)) tabela.quantidade++;
+        else tabela.reserva.push_back(t);
+    }
+    tabela.limite_reserva = max(LIMITE_RESERVA, 2 * tabela.reserva.size());
+}
+
+// Inicia um rehash se a carga passou do limite ou a reserva encheu. Com carga
+// baixa a culpa e das sementes: o tamanho fica e so as sementes mudam.
+void verificar_carga() {
+    size_t slots = (size_t)tabela.atual.num_baldes * SLOTS_POR_BALDE;
+    bool cheia = tabela.quantidade > slots * CARGA_MAXIMA;
+    if (!cheia && tabela.reserva.size() <= tabela.limite_reserva) return;
+
+    // Um rehash anterior ainda aberto e concluido antes de abrir outro
+    if (tabela.antiga.impressoes) {
+        migrar_baldes(tabela.antiga.num_baldes);
+        cheia = tabela.quantidade > slots * CARGA_MAXIMA;
+        if (!cheia && tabela.reserva.size() <= tabela.limite_reserva) return;
+    }
+
+    unsigned int num_baldes = tabela.atual.num_baldes;
+    if (cheia || tabela.quantidade + tabela.reserva.size() > slots * CARGA_DOBRAR) num_baldes *= 2;
+    tabela.antiga = tabela.atual;
+    tabela.atual = criar_arranjo(num_baldes, tabela.antiga.semente + 2);
+    tabela.proximo_migrar = 0;
+    tabela.rehashes++;
+}
+//Inserção de transação
+void insert(Transaction* trans) {
+    migrar_baldes(BALDES_POR_PASSO);
+    trans->chave = codec_id_codificar(trans->transaction_id);
+    if (colocar(tabela.atual, trans)) tabela.quantidade++;
+    else tabela.reserva.push_back(trans);
+    verificar_carga();
+}
+
+// Onde a chave esta: num balde (arranjo, balde, slot) ou na reserva (indice)
+struct Local {
+    ArranjoCuckoo* arranjo;
+    unsigned int balde;
+    int slot;
+    int reserva;
+};
+
+// Durante um rehash a chave pode estar no arranjo atual ou num balde ainda nao
+// migrado do antigo (os ja migrados ficam vazios)
+bool localizar(const char* id, Local* local) {
+    uint64_t chave = codec_id_codificar(id);
+    ArranjoCuckoo* arranjos[2] = {&tabela.atual, &tabela.antiga};
+    for (ArranjoCuckoo* a : arranjos) {
+        if (!a->impressoes) continue;
+        Posicao p = posicao(*a, chave);
+        unsigned int baldes[2] = {p.balde1, p.balde2};
+        for (unsigned int b : baldes) {
+            int s = procurar_no_balde(*a, b, p.impressao, chave, id);
+            if (s >= 0) {
+                *local = {a, b, s, -1};
+                return true;
+            }
+        }
+    }
+    int r = procurar_na_reserva(chave, id);
+    if (r < 0) return false;
+    *local = {nullptr, 0, -1, r};
+    return true;
+}
 //Busca de transação por ID
 Transaction* search(const char* id) {
-    unsigned int index1 = hash1(id);
-    if (table1[index1] && strcmp(table1[index1]->transaction_id, id) == 0)
-        return table1[index1];
-    unsigned int index2 = hash2(id);
-    if (table2[index2] && strcmp(table2[index2]->transaction_id, id) == 0)
-        return table2[index2];
+    migrar_baldes(BALDES_POR_PASSO);
+    Local local;
+    if (localizar(id, &local))
+        return local.arranjo ? local.arranjo->slots[local.balde][local.slot] : tabela.reserva[local.reserva];
     
     cout << "Transacao com ID '" << id << "' nao encontrada.\n";
     return nullptr;
 }
 //Remoção de transação por ID
 bool remove_transaction(const char* id) {
-    unsigned int index1 = hash1(id);
-    if (table1[index1] && strcmp(table1[index1]->transaction_id, id) == 0) {
-        delete table1[index1];
-        table1[index1] = nullptr;
-        return true;
-    }
-    unsigned int index2 = hash2(id);
-    if (table2[index2] && strcmp(table2[index2]->transaction_id, id) == 0) {
-        delete table2[index2];
-        table2[index2] = nullptr;
-        return true;
+    migrar_baldes(BALDES_POR_PASSO);
+    Local local;
+    if (!localizar(id, &local)) return false;
+    if (local.arranjo) {
+        delete local.arranjo->slots[local.balde][local.slot];
+        local.arranjo->slots[local.balde][local.slot] = nullptr;
+        local.arranjo->impressoes[local.balde][local.slot] = 0;
+        tabela.quantidade--;
+    } else {
+        delete tabela.reserva[local.reserva];
+        tabela.reserva[local.reserva] = tabela.reserva.back();
+        tabela.reserva.pop_back();
     }
-    return false;
+    return true;
+}
+//Conversao de uma linha do CSV para Transaction
+bool converter_linha(const LinhaCSV* linha, void* destino) {
+    Transaction* t = (Transaction*)destino;
+    if (!csv_linha_completa(linha)) return false; // Mesmo criterio do snapshot (fdb_gravar)
+    CSV_COPIAR(t->transaction_id, linha->campos[CAMPO_ID]);
+    CSV_COPIAR(t->timestamp, linha->campos[CAMPO_TIMESTAMP]);
+    CSV_COPIAR(t->sender_account, linha->campos[CAMPO_SENDER]);
+    CSV_COPIAR(t->receiver_account, linha->campos[CAMPO_RECEIVER]);
+    t->amount = csv_linha_amount(linha);
+    CSV_COPIAR(t->transaction_type, linha->campos[CAMPO_TIPO]);
+    CSV_COPIAR(t->merchant_category, linha->campos[CAMPO_CATEGORIA]);
+    CSV_COPIAR(t->location, linha->campos[CAMPO_LOCAL]);
+    CSV_COPIAR(t->device_used, linha->campos[CAMPO_DISPOSITIVO]);
+    return true;
+}
+
+void inserir_registro(void* registro, void* contexto) {
+    (void)contexto;
+    insert(new Transaction(*(Transaction*)registro));
 }
 //Leitura de Dataset
 void read_csv(const char* filename) {
-    ifstream file(filename);
-    string line;
-    getline(file, line); // Cabeçalho
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string id, ts, sender, receiver, amt, type, category, loc, device;
-        getline(ss, id, ',');
-        getline(ss, ts, ',');
-        getline(ss, sender, ',');
-        getline(ss, receiver, ',');
-        getline(ss, amt, ',');
-        getline(ss, type, ',');
-        getline(ss, category, ',');
-        getline(ss, loc, ',');
-        getline(ss, device, ',');
-
-        Transaction* t = new Transaction;
-        strncpy(t->transaction_id, id.c_str(), sizeof(t->transaction_id));
-        strncpy(t->timestamp, ts.c_str(), sizeof(t->timestamp));
-        strncpy(t->sender_account, sender.c_str(), sizeof(t->sender_account));
-        strncpy(t->receiver_account, receiver.c_str(), sizeof(t->receiver_account));
-        t->amount = amt.empty() ? 0.0f : stof(amt);
-        strncpy(t->transaction_type, type.c_str(), sizeof(t->transaction_type));
-        strncpy(t->merchant_category, category.c_str(), sizeof(t->merchant_category));
-        strncpy(t->location, loc.c_str(), sizeof(t->location));
-        strncpy(t->device_used, device.c_str(), sizeof(t->device_used));
-        insert(t);
-    }
-    file.close();
+    if (!fdb_carregar_ou_gerar(filename, sizeof(Transaction), converter_linha, inserir_registro, NULL, CSV_THREADS_AUTO))
+        cout << "Erro ao abrir o arquivo: " << filename << "\n";
 }
 
 void print_transaction(Transaction* t) {
@@ -141,24 +403,14 @@ void calcular_estatisticas() {
     int count = 0;
     float min_val = INFINITY, max_val = -INFINITY;
 
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        if (table1[i]) {
-            float val = table1[i]->amount;
-            valores.push_back(val);
-            soma += val;
-            min_val = min(min_val, val);
-            max_val = max(max_val, val);
-            count++;
-        }
-        if (table2[i]) {
-            float val = table2[i]->amount;
-            valores.push_back(val);
-            soma += val;
-            min_val = min(min_val, val);
-            max_val = max(max_val, val);
-            count++;
-        }
-    }
+    para_cada_transacao([&](Transaction* t) {
+        float val = t->amount;
+        valores.push_back(val);
+        soma += val;
+        min_val = min(min_val, val);
+        max_val = max(max_val, val);
+        count++;
+    });
 
     if (count == 0) {
         cout << "Nenhuma transacao disponivel.\n";
@@ -187,26 +439,49 @@ void calcular_estatisticas() {
 void agrupar_por_feature(const string& feature) {
     map<string, int> contagem;
 
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        auto processar = [&](Transaction* t) {
-            if (!t) return;
-            string chave;
-            if (feature == "transaction_type") chave = t->transaction_type;
-            else if (feature == "location") chave = t->location;
-            else if (feature == "device_used") chave = t->device_used;
-            else if (feature == "merchant_category") chave = t->merchant_category;
-            else chave = "Desconhecido";
-            contagem[chave]++;
-        };
-        processar(table1[i]);
-        processar(table2[i]);
-    }
+    para_cada_transacao([&](Transaction* t) {
+        string chave;
+        if (feature == "transaction_type") chave = t->transaction_type;
+        else if (feature == "location") chave = t->location;
+        else if (feature == "device_used") chave = t->device_used;
+        else if (feature == "merchant_category") chave = t->merchant_category;
+        else chave = "Desconhecido";
+        contagem[chave]++;
+    });
 
     cout << "\nAgrupamento por '" << feature << "':\n";
     for (const auto& par : contagem)
         cout << par.first << ": " << par.second << " transacoes\n";
 }
 
+// Bytes do indice: impressoes e ponteiros dos arranjos mais a reserva
+size_t memoria_indice() {
+    size_t por_balde = sizeof(*tabela.atual.impressoes) + sizeof(*tabela.atual.slots);
+    return sizeof(tabela) + ((size_t)tabela.atual.num_baldes + tabela.antiga.num_baldes) * por_balde +
+           tabela.reserva.capacity() * sizeof(Transaction*);
+}
+
+// Ocupacao dos baldes, reserva, memoria e custo dos deslocamentos e rehashes
+void estatisticas_tabela() {
+    size_t slots = (size_t)tabela.atual.num_baldes * SLOTS_POR_BALDE;
+    size_t cheios = 0;
+    for (unsigned int b = 0; b < tabela.atual.num_baldes; ++b)
+        if (slot_livre(tabela.atual, b) < 0) cheios++;
+
+    cout << "Baldes: " << tabela.atual.num_baldes << " x " << SLOTS_POR_BALDE << " slots\n";
+    cout << "Registros nos baldes: " << tabela.quantidade << "\n";
+    cout << "Fator de carga: " << (slots ? tabela.quantidade * 100.0 / slots : 0.0) << "%\n";
+    cout << "Baldes cheios: " << cheios << "\n";
+    cout << "Registros na reserva: " << tabela.reserva.size() << "\n";
+    cout << "Deslocamentos: " << tabela.deslocamentos << " (maior caminho: " << tabela.maior_caminho << ")\n";
+    cout << "Rehashes: " << tabela.rehashes << " (sementes " << tabela.atual.semente << " e " << tabela.atual.semente + 1 << ")\n";
+    if (tabela.antiga.impressoes)
+        cout << "Rehash em andamento: " << tabela.proximo_migrar << " de " << tabela.antiga.num_baldes << " baldes migrados\n";
+    size_t registros = (tabela.quantidade + tabela.reserva.size()) * sizeof(Transaction);
+    cout << "Memoria do indice: " << memoria_indice() / (1024.0 * 1024.0) << " MB\n";
+    cout << "Memoria dos registros: " << registros / (1024.0 * 1024.0) << " MB\n";
+}
+
 void menu() {
     int opcao;
     do {
@@ -217,6 +492,7 @@ void menu() {
         cout << "4. Estatisticas\n";
         cout << "5. Agrupamento por tipo\n";
         cout << "6. Sair\n";
+        cout << "7. Estatisticas da tabela cuckoo\n";
         cout << "Escolha: ";
         cin >> opcao;
         cin.ignore();
@@ -278,6 +554,9 @@ void menu() {
             case 6:
                 cout << "Encerrando...\n";
                 break;
+            case 7:
+                estatisticas_tabela();
+                break;
             default:
                 cout << "Opcao invalida.\n";
         }
@@ -285,15 +564,11 @@ void menu() {
 }
 
 int main() {
-    memset(table1, 0, sizeof(table1));
-    memset(table2, 0, sizeof(table2));
-
-    read_csv("C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv");
+    const char* caminho = "C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv";
+    init_tabela(fdb_estimar_linhas(caminho));
+    read_csv(caminho);
     menu();
 
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        if (table1[i]) delete table1[i];
-        if (table2[i]) delete table2[i];
-    }
+    liberar_tabela();
     return 0;
 }
\ No newline at end of file
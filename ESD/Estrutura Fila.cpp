@@ -3,6 +3,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include <math.h>
+#include "leitor_csv.h"
 
 // Estrutura de uma transação
 typedef struct Transaction {
@@ -239,34 +240,34 @@ bool prever_fraude(Transaction* t) {
     return (t->amount > 10000 || strcmp(t->device_used, "unknown") == 0);
 }
 
+//Conversao de uma linha do CSV para Transaction
+bool converter_linha(const LinhaCSV* linha, void* destino) {
+    Transaction* t = (Transaction*)destino;
+    if (!csv_linha_completa(linha)) return false;
+    CSV_COPIAR(t->transaction_id, linha->campos[CAMPO_ID]);
+    CSV_COPIAR(t->timestamp, linha->campos[CAMPO_TIMESTAMP]);
+    CSV_COPIAR(t->sender_account, linha->campos[CAMPO_SENDER]);
+    CSV_COPIAR(t->receiver_account, linha->campos[CAMPO_RECEIVER]);
+    t->amount = csv_linha_amount(linha);
+    CSV_COPIAR(t->transaction_type, linha->campos[CAMPO_TIPO]);
+    CSV_COPIAR(t->merchant_category, linha->campos[CAMPO_CATEGORIA]);
+    CSV_COPIAR(t->location, linha->campos[CAMPO_LOCAL]);
+    CSV_COPIAR(t->device_used, linha->campos[CAMPO_DISPOSITIVO]);
+    t->is_fraud = csv_campo_fraude(linha->campos[CAMPO_FRAUDE]);
+    return true;
+}
+
+void inserir_registro(void* registro, void* contexto) {
+    (void)contexto;
+    enqueue(*(Transaction*)registro);
+}
+
 // Carregar Dataset
 void load_csv(const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
+    if (!csv_carregar(filename, sizeof(Transaction), converter_linha, inserir_registro, NULL, CSV_THREADS_AUTO)) {
         perror("Erro ao abrir o arquivo");
         exit(1);
     }
-
-    char line[512];
-    fgets(line, sizeof(line), file); // Ignora o cabeçalho
-
-    while (fgets(line, sizeof(line), file)) {
-        Transaction t;
-        char is_fraud_str[6];
-
-        int lidos = sscanf(line, "%15[^,],%31[^,],%31[^,],%31[^,],%f,%15[^,],%31[^,],%31[^,],%15[^,],%5[^,\n]",
-            t.transaction_id, t.timestamp, t.sender_account, t.receiver_account, &t.amount,
-            t.transaction_type, t.merchant_category, t.location, t.device_used, is_fraud_str);
-
-        if (lidos == 10) {
-            t.is_fraud = strcmp(is_fraud_str, "True") == 0;
-            enqueue(t);
-        } else {
-            fprintf(stderr, "Linha ignorada: %s", line);
-        }
-    }
-
-    fclose(file);
 }
 
 Transaction** copiar_para_array(int* total) {
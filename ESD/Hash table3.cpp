@@ -3,8 +3,20 @@
 #include <string.h>
 #include <stdbool.h>
 #include <math.h> 
-
-#define TABLE_SIZE 10007
+#include "leitor_csv.h"
+#include "snapshot_fdb.h"
+#include "hash_rapido.h"
+#include "codec_id.h"
+#include "filtro_bloom.h"
+
+#define TAMANHO_INICIAL 1024   // Baldes da tabela vazia (potencia de 2)
+#define CARGA_MAXIMA 1.0        // Acima disso a tabela dobra
+#define CARGA_MINIMA 0.25       // Abaixo disso a tabela cai pela metade
+#define BALDES_POR_PASSO 4      // Baldes migrados a cada operacao durante um rehash
+#define CONTAS_FPR_ALVO 0.01    // Falsos positivos dos filtros de contas
+#define CONTAS_FPR_LIMITE 0.02  // Acima disso (estimado) os filtros sao reconstruidos
+#define CONTAS_FOLGA 2          // Capacidade da reconstrucao: transacoes * folga
+#define CONTAS_CHAVES_MINIMAS 1024
 
 typedef struct Transaction {
     char transaction_id[16];
@@ -17,90 +29,295 @@ typedef struct Transaction {
     char location[32];
     char device_used[16];
     bool is_fraud;
+    uint64_t chave; // transaction_id codificado, preenchido na insercao
     struct Transaction* next;
 } Transaction;
 
-Transaction* hash_table[TABLE_SIZE];
+// Tabela com encadeamento que cresce e encolhe pelo fator de carga. O rehash
+// e incremental: a tabela antiga fica ativa e cada operacao migra alguns
+// baldes dela para a nova, entao nenhuma insercao paga o rehash inteiro.
+typedef struct TabelaHash {
+    Transaction** baldes;     // Tabela atual, recebe todas as insercoes
+    size_t tamanho;
+    Transaction** antiga;     // Tabela sendo esvaziada (NULL fora de um rehash)
+    size_t tamanho_antiga;
+    size_t proximo_migrar;    // Proximo balde da antiga a ser migrado
+    size_t quantidade;
+} TabelaHash;
+
+TabelaHash hash_table;
+
+// Filtros de Bloom (filtro_bloom.h) das contas de origem e destino: "a conta X
+// ja enviou/recebeu algo?" sai sem percorrer a tabela quando a conta nao
+// existe. Sao dimensionados pelas transacoes, que limitam as contas distintas.
+// Sem contagem: a remocao deixa os bits da conta ligados, o que so custa uma
+// varredura a mais (nunca um falso negativo) ate a proxima reconstrucao.
+FiltroBloom filtro_remetentes;
+FiltroBloom filtro_destinatarios;
+int reconstrucoes_contas = 0;
+
+uint64_t hash_conta(const char* conta) {
+    return hash_texto(conta);
+}
+
+void iniciar_filtros_contas(size_t transacoes) {
+    if (transacoes < CONTAS_CHAVES_MINIMAS) transacoes = CONTAS_CHAVES_MINIMAS;
+    if (!bloom_iniciar(&filtro_remetentes, transacoes, CONTAS_FPR_ALVO) ||
+        !bloom_iniciar(&filtro_destinatarios, transacoes, CONTAS_FPR_ALVO)) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        exit(1);
+    }
+    bloom_definir_limite(&filtro_remetentes, CONTAS_FPR_LIMITE);
+    bloom_definir_limite(&filtro_destinatarios, CONTAS_FPR_LIMITE);
+}
+
+void adicionar_contas(const Transaction* t) {
+    bloom_inserir(&filtro_remetentes, hash_conta(t->sender_account));
+    bloom_inserir(&filtro_destinatarios, hash_conta(t->receiver_account));
+}
+
+void reconstruir_filtros_contas();
+
+// A tabela hasheia a chave inteira do transaction_id (codec_id.h): o texto
+// so e lido de novo para confirmar IDs fora do formato T/TRN + digitos
+uint64_t hash(uint64_t chave) {
+    return codec_id_hash(chave, 0);
+}
+
+Transaction** alocar_baldes(size_t tamanho) {
+    Transaction** baldes = (Transaction**)calloc(tamanho, sizeof(Transaction*));
+    if (!baldes) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        exit(1);
+    }
+    return baldes;
+}
+
+void init_hash_table() {
+    hash_table.tamanho = TAMANHO_INICIAL;
+    hash_table.baldes = alocar_baldes(TAMANHO_INICIAL);
+    hash_table.antiga = NULL;
+    hash_table.tamanho_antiga = 0;
+    hash_table.proximo_migrar = 0;
+    hash_table.quantidade = 0;
+}
+
+// Move ate "limite" baldes da tabela antiga para a atual
+void migrar_baldes(size_t limite) {
+    if (!hash_table.antiga) return;
+    while (limite-- > 0 && hash_table.proximo_migrar < hash_table.tamanho_antiga) {
+        Transaction* t = hash_table.antiga[hash_table.proximo_migrar];
+        hash_table.antiga[hash_table.proximo_migrar++] = NULL;
+        while (t) {
+            Transaction* prox = t->next;
+            size_t index = hash_balde(hash(t->chave), hash_table.tamanho);
+            t->next = hash_table.baldes[index];
+            hash_table.baldes[index] = t;
+            t = prox;
+        }
+    }
+    if (hash_table.proximo_migrar == hash_table.tamanho_antiga) {
+        free(hash_table.antiga);
+        hash_table.antiga = NULL;
+        hash_table.tamanho_antiga = 0;
+        hash_table.proximo_migrar = 0;
+    }
+}
 
-unsigned int hash(const char* str) {
-    unsigned int hash = 5381;
-    int c;
-    while ((c = *str++))
-        hash = ((hash << 5) + hash) + c;
-    return hash % TABLE_SIZE;
+// Inicia um rehash se o fator de carga saiu dos limites
+void verificar_carga() {
+    size_t novo_tamanho = hash_table.tamanho;
+    if (hash_table.quantidade > hash_table.tamanho * CARGA_MAXIMA)
+        novo_tamanho = hash_table.tamanho * 2;
+    else if (hash_table.tamanho > TAMANHO_INICIAL && hash_table.quantidade < hash_table.tamanho * CARGA_MINIMA)
+        novo_tamanho = hash_table.tamanho / 2;
+    if (novo_tamanho == hash_table.tamanho) return;
+
+    // Um rehash anterior ainda aberto e concluido antes de abrir outro
+    if (hash_table.antiga) migrar_baldes(hash_table.tamanho_antiga);
+
+    hash_table.antiga = hash_table.baldes;
+    hash_table.tamanho_antiga = hash_table.tamanho;
+    hash_table.proximo_migrar = 0;
+    hash_table.baldes = alocar_baldes(novo_tamanho);
+    hash_table.tamanho = novo_tamanho;
 }
+
+// Ponteiro que aponta para o no da chave (cabeca do balde ou campo next do
+// anterior), ou NULL. Durante um rehash a chave pode estar no balde ainda nao
+// migrado da tabela antiga ou na atual, onde caem as insercoes novas.
+Transaction** localizar_transacao(const char* transaction_id) {
+    uint64_t chave = codec_id_codificar(transaction_id);
+    uint64_t h = hash(chave);
+    for (int tabela = 0; tabela < 2; tabela++) {
+        Transaction** ligacao;
+        if (tabela == 0) {
+            if (!hash_table.antiga || hash_balde(h, hash_table.tamanho_antiga) < hash_table.proximo_migrar) continue;
+            ligacao = &hash_table.antiga[hash_balde(h, hash_table.tamanho_antiga)];
+        } else {
+            ligacao = &hash_table.baldes[hash_balde(h, hash_table.tamanho)];
+        }
+        while (*ligacao) {
+            if (codec_id_iguais((*ligacao)->chave, (*ligacao)->transaction_id, chave, transaction_id))
+                return ligacao;
+            ligacao = &(*ligacao)->next;
+        }
+    }
+    return NULL;
+}
+
 //Inserção de uma nova transação
 void insert_transaction(Transaction t) {
-    unsigned int index = hash(t.transaction_id);
+    migrar_baldes(BALDES_POR_PASSO);
     Transaction* new_node = (Transaction*)malloc(sizeof(Transaction));
     if (!new_node) {
         fprintf(stderr, "Erro de alocacao de memoria.\n");
         exit(1);
     }
     *new_node = t;
-    new_node->next = hash_table[index];
-    hash_table[index] = new_node;
+    new_node->chave = codec_id_codificar(t.transaction_id);
+    size_t index = hash_balde(hash(new_node->chave), hash_table.tamanho);
+    new_node->next = hash_table.baldes[index];
+    hash_table.baldes[index] = new_node;
+    hash_table.quantidade++;
+    adicionar_contas(new_node);
+    if (bloom_precisa_reconstruir(&filtro_remetentes) || bloom_precisa_reconstruir(&filtro_destinatarios))
+        reconstruir_filtros_contas();
+    verificar_carga();
 }
 //Busca por ID de transação
 Transaction* search_transaction(const char* transaction_id) {
-    unsigned int index = hash(transaction_id);
-    Transaction* current = hash_table[index];
-    while (current) {
-        if (strcmp(current->transaction_id, transaction_id) == 0)
-            return current;
-        current = current->next;
-    }
-    return NULL;
+    migrar_baldes(BALDES_POR_PASSO);
+    Transaction** ligacao = localizar_transacao(transaction_id);
+    return ligacao ? *ligacao : NULL;
 }
 //Remoção de transação por ID
 void remove_transaction(const char* transaction_id) {
-    unsigned int index = hash(transaction_id);
-    Transaction* current = hash_table[index];
-    Transaction* prev = NULL;
-
-    while (current) {
-        if (strcmp(current->transaction_id, transaction_id) == 0) {
-            if (prev)
-                prev->next = current->next;
-            else
-                hash_table[index] = current->next;
-            free(current);
-            printf("Transacao %s removida.\n", transaction_id);
-            return;
-        }
-        prev = current;
-        current = current->next;
+    migrar_baldes(BALDES_POR_PASSO);
+    Transaction** ligacao = localizar_transacao(transaction_id);
+    if (!ligacao) {
+        printf("Transacao %s nao encontrada.\n", transaction_id);
+        return;
     }
-    printf("Transacao %s nao encontrada.\n", transaction_id);
+    Transaction* current = *ligacao;
+    *ligacao = current->next;
+    free(current);
+    hash_table.quantidade--;
+    verificar_carga();
+    printf("Transacao %s removida.\n", transaction_id);
 }
-//Leitura do Dataset
-void load_csv(const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        perror("Erro ao abrir o arquivo");
-        exit(1);
-    }
 
-    char line[512];
-    fgets(line, sizeof(line), file);
+// Percorre todas as transacoes, inclusive as que ainda estao na tabela antiga
+typedef struct IteradorHash {
+    Transaction** baldes;
+    size_t tamanho;
+    size_t balde;
+    Transaction* atual;
+    bool na_antiga;
+} IteradorHash;
+
+Transaction* proxima_transacao(IteradorHash* it) {
+    if (it->atual) it->atual = it->atual->next;
+    for (;;) {
+        if (it->atual) return it->atual;
+        if (it->balde < it->tamanho) {
+            it->atual = it->baldes[it->balde++];
+            continue;
+        }
+        if (!it->na_antiga || !hash_table.baldes) return NULL;
+        it->na_antiga = false; // Terminou a antiga, segue pela atual
+        it->baldes = hash_table.baldes;
+        it->tamanho = hash_table.tamanho;
+        it->balde = 0;
+    }
+}
 
-    while (fgets(line, sizeof(line), file)) {
-        Transaction t;
-        char is_fraud_str[6];
+Transaction* primeira_transacao(IteradorHash* it) {
+    it->na_antiga = hash_table.antiga != NULL;
+    it->baldes = it->na_antiga ? hash_table.antiga : hash_table.baldes;
+    it->tamanho = it->na_antiga ? hash_table.tamanho_antiga : hash_table.tamanho;
+    it->balde = 0;
+    it->atual = NULL;
+    return proxima_transacao(it);
+}
 
-        int campos_lidos = sscanf(line, "%15[^,],%31[^,],%31[^,],%31[^,],%f,%15[^,],%31[^,],%31[^,],%15[^,],%5[^,\n]",
-               t.transaction_id, t.timestamp, t.sender_account, t.receiver_account, &t.amount,
-               t.transaction_type, t.merchant_category, t.location, t.device_used, is_fraud_str);
+// Refaz os filtros de contas com as transacoes presentes quando a taxa
+// estimada passa do limite (dataset maior que o previsto ou muitas insercoes)
+void reconstruir_filtros_contas() {
+    bloom_liberar(&filtro_remetentes);
+    bloom_liberar(&filtro_destinatarios);
+    iniciar_filtros_contas(hash_table.quantidade * CONTAS_FOLGA);
+    IteradorHash it;
+    for (Transaction* t = primeira_transacao(&it); t; t = proxima_transacao(&it))
+        adicionar_contas(t);
+    reconstrucoes_contas++;
+}
 
-        if (campos_lidos == 10) {
-            t.is_fraud = strcmp(is_fraud_str, "True") == 0;
-            insert_transaction(t);
-        } else {
-            fprintf(stderr, "Linha ignorada por formato inválido: %s", line);
+// Fator de carga e distribuicao do tamanho das cadeias
+void estatisticas_tabela() {
+    size_t ocupados = 0, maior_cadeia = 0;
+    size_t histograma[6] = {0}; // 0, 1, 2, 3, 4 e 5+ transacoes por balde
+
+    for (int tabela = 0; tabela < 2; tabela++) {
+        Transaction** baldes = tabela == 0 ? hash_table.baldes : hash_table.antiga;
+        size_t inicio = tabela == 0 ? 0 : hash_table.proximo_migrar;
+        size_t fim = tabela == 0 ? hash_table.tamanho : hash_table.tamanho_antiga;
+        if (!baldes) continue;
+        for (size_t i = inicio; i < fim; i++) {
+            size_t cadeia = 0;
+            for (Transaction* t = baldes[i]; t; t = t->next) cadeia++;
+            histograma[cadeia < 5 ? cadeia : 5]++;
+            if (cadeia > 0) ocupados++;
+            if (cadeia > maior_cadeia) maior_cadeia = cadeia;
         }
     }
 
-    fclose(file);
+    size_t baldes_ativos = hash_table.tamanho + (hash_table.antiga ? hash_table.tamanho_antiga - hash_table.proximo_migrar : 0);
+    printf("\n=== Estatisticas da Tabela Hash ===\n");
+    printf("Transacoes: %zu\n", hash_table.quantidade);
+    printf("Baldes: %zu\n", hash_table.tamanho);
+    printf("Fator de carga: %.3f (limites %.2f - %.2f)\n",
+           (double)hash_table.quantidade / hash_table.tamanho, CARGA_MINIMA, CARGA_MAXIMA);
+    if (hash_table.antiga)
+        printf("Rehash em andamento: %zu de %zu baldes migrados\n", hash_table.proximo_migrar, hash_table.tamanho_antiga);
+    printf("Baldes ocupados: %zu (%.2f%%)\n", ocupados, baldes_ativos ? ocupados * 100.0 / baldes_ativos : 0.0);
+    printf("Maior cadeia: %zu\n", maior_cadeia);
+    printf("Media por balde ocupado: %.3f\n", ocupados ? (double)hash_table.quantidade / ocupados : 0.0);
+    printf("Distribuicao das cadeias:\n");
+    for (int i = 0; i < 6; i++)
+        printf("  %s%d: %zu baldes\n", i == 5 ? ">=" : "", i, histograma[i]);
+    printf("Filtros de contas: %.2f KB cada | falsos positivos estimados: %.4f%% (remetentes), %.4f%% (destinatarios) | reconstrucoes: %d\n",
+           bloom_memoria(&filtro_remetentes) / 1024.0, bloom_fpr_estimada(&filtro_remetentes) * 100.0,
+           bloom_fpr_estimada(&filtro_destinatarios) * 100.0, reconstrucoes_contas);
+}
+//Conversao de uma linha do CSV para Transaction
+bool converter_linha(const LinhaCSV* linha, void* destino) {
+    Transaction* t = (Transaction*)destino;
+    if (!csv_linha_completa(linha)) return false;
+    CSV_COPIAR(t->transaction_id, linha->campos[CAMPO_ID]);
+    CSV_COPIAR(t->timestamp, linha->campos[CAMPO_TIMESTAMP]);
+    CSV_COPIAR(t->sender_account, linha->campos[CAMPO_SENDER]);
+    CSV_COPIAR(t->receiver_account, linha->campos[CAMPO_RECEIVER]);
+    t->amount = csv_linha_amount(linha);
+    CSV_COPIAR(t->transaction_type, linha->campos[CAMPO_TIPO]);
+    CSV_COPIAR(t->merchant_category, linha->campos[CAMPO_CATEGORIA]);
+    CSV_COPIAR(t->location, linha->campos[CAMPO_LOCAL]);
+    CSV_COPIAR(t->device_used, linha->campos[CAMPO_DISPOSITIVO]);
+    t->is_fraud = csv_campo_fraude(linha->campos[CAMPO_FRAUDE]);
+    return true;
+}
+
+void inserir_registro(void* registro, void* contexto) {
+    (void)contexto;
+    insert_transaction(*(Transaction*)registro);
+}
+
+//Leitura do Dataset
+void load_csv(const char* filename) {
+    if (!fdb_carregar_ou_gerar(filename, sizeof(Transaction), converter_linha, inserir_registro, NULL, CSV_THREADS_AUTO)) {
+        perror("Erro ao abrir o arquivo");
+        exit(1);
+    }
 }
 
 // Função de comparação para qsort
@@ -117,15 +334,8 @@ void calcular_estatisticas() {
     float soma = 0, maior = 0, menor = -1;
     int total_fraudes = 0;
 
-    // Primeiro passagem: contar transações e alocar memória
-    int total_transacoes = 0;
-    for (int i = 0; i < TABLE_SIZE; i++) {
-        Transaction* t = hash_table[i];
-        while (t) {
-            total_transacoes++;
-            t = t->next;
-        }
-    }
+    // A tabela ja conhece a quantidade de transacoes
+    int total_transacoes = (int)hash_table.quantidade;
 
     if (total_transacoes == 0) {
         printf("Nenhuma transacao registrada.\n");
@@ -139,21 +349,18 @@ void calcular_estatisticas() {
         return;
     }
 
-    // Segunda passagem: coletar dados
-    for (int i = 0; i < TABLE_SIZE; i++) {
-        Transaction* t = hash_table[i];
-        while (t) {
-            float v = t->amount;
-            valores[total++] = v;
-            soma += v;
-            
-            if (menor < 0 || v < menor) menor = v;
-            if (v > maior) maior = v;
-            
-            if (t->is_fraud) total_fraudes++;
-            
-            t = t->next;
-        }
+    // Coletar dados (percorre tambem a tabela antiga durante um rehash)
+    IteradorHash it;
+    for (Transaction* t = primeira_transacao(&it); t; t = proxima_transacao(&it)) {
+        float v = t->amount;
+        valores[total++] = v;
+        soma += v;
+        
+        if (menor < 0 || v < menor) menor = v;
+        if (v > maior) maior = v;
+        
+        if (t->is_fraud) total_fraudes++;
+        
     }
 
     float media = soma / total;
@@ -235,23 +442,20 @@ void agrupar_por_campo(int campo) {
     Grupo* grupos = NULL;
     const char* titulo = "";
     
-    for (int i = 0; i < TABLE_SIZE; i++) {
-        Transaction* t = hash_table[i];
-        while (t) {
-            const char* chave = "";
-            switch (campo) {
-                case 1: chave = t->transaction_type; titulo = "Tipo de Transacao"; break;
-                case 2: chave = t->merchant_category; titulo = "Categoria do Comerciante"; break;
-                case 3: chave = t->location; titulo = "Localizacao"; break;
-                case 4: chave = t->device_used; titulo = "Dispositivo Usado"; break;
-                case 5: chave = t->sender_account; titulo = "Conta do Remetente"; break;
-                case 6: chave = t->receiver_account; titulo = "Conta do Destinatario"; break;
-                default: chave = "Indefinido"; titulo = "Indefinido";
-            }
-            
-            inserir_grupo(&grupos, chave, t->amount);
-            t = t->next;
+    IteradorHash it;
+    for (Transaction* t = primeira_transacao(&it); t; t = proxima_transacao(&it)) {
+        const char* chave = "";
+        switch (campo) {
+            case 1: chave = t->transaction_type; titulo = "Tipo de Transacao"; break;
+            case 2: chave = t->merchant_category; titulo = "Categoria do Comerciante"; break;
+            case 3: chave = t->location; titulo = "Localizacao"; break;
+            case 4: chave = t->device_used; titulo = "Dispositivo Usado"; break;
+            case 5: chave = t->sender_account; titulo = "Conta do Remetente"; break;
+            case 6: chave = t->receiver_account; titulo = "Conta do Destinatario"; break;
+            default: chave = "Indefinido"; titulo = "Indefinido";
         }
+        
+        inserir_grupo(&grupos, chave, t->amount);
     }
     
     printf("\n=== Agrupamento por %s ===\n", titulo);
@@ -283,6 +487,7 @@ void filtrar_transacoes() {
     printf("2. Valor acima de um limite\n");
     printf("3. Valor abaixo de um limite\n");
     printf("4. Por sender_account\n");
+    printf("5. Por receiver_account\n");
     printf("Escolha uma opcao: ");
     scanf("%d", &opcao);
     getchar();
@@ -307,37 +512,49 @@ void filtrar_transacoes() {
             fgets(conta, sizeof(conta), stdin);
             conta[strcspn(conta, "\n")] = '\0'; // remove newline
             break;
+        case 5:
+            printf("Digite o receiver_account: ");
+            fgets(conta, sizeof(conta), stdin);
+            conta[strcspn(conta, "\n")] = '\0';
+            break;
     }
 
-    for (int i = 0; i < TABLE_SIZE; i++) {
-        Transaction* t = hash_table[i];
-        while (t) {
-            bool exibir = false;
-
-            switch (opcao) {
-                case 1:
-                    exibir = t->is_fraud;
-                    break;
-                case 2:
-                    exibir = t->amount >= limite;
-                    break;
-                case 3:
-                    exibir = t->amount <= limite;
-                    break;
-                case 4:
-                    exibir = strcmp(t->sender_account, conta) == 0;
-                    break;
-                default:
-                    printf("Opcao invalida!\n");
-                    return;
-            }
+    // Conta ausente no filtro: nenhuma transacao a mostrar, sem varrer a tabela
+    if ((opcao == 4 && !bloom_contem(&filtro_remetentes, hash_conta(conta))) ||
+        (opcao == 5 && !bloom_contem(&filtro_destinatarios, hash_conta(conta)))) {
+        printf("Nenhuma transacao para a conta %s.\n", conta);
+        return;
+    }
 
-            if (exibir) {
-                printf("\nID: %s | Valor: %.2f | Fraude: %s\n", t->transaction_id, t->amount, t->is_fraud ? "Sim" : "Nao");
-            }
+    IteradorHash it;
+    for (Transaction* t = primeira_transacao(&it); t; t = proxima_transacao(&it)) {
+        bool exibir = false;
+
+        switch (opcao) {
+            case 1:
+                exibir = t->is_fraud;
+                break;
+            case 2:
+                exibir = t->amount >= limite;
+                break;
+            case 3:
+                exibir = t->amount <= limite;
+                break;
+            case 4:
+                exibir = strcmp(t->sender_account, conta) == 0;
+                break;
+            case 5:
+                exibir = strcmp(t->receiver_account, conta) == 0;
+                break;
+            default:
+                printf("Opcao invalida!\n");
+                return;
+        }
 
-            t = t->next;
+        if (exibir) {
+            printf("\nID: %s | Valor: %.2f | Fraude: %s\n", t->transaction_id, t->amount, t->is_fraud ? "Sim" : "Nao");
         }
+
     }
 }
 
@@ -348,16 +565,8 @@ int compare_transactions(const void* a, const void* b) {
 }
 //Ordenação dos dados
 void ordenar_transacoes() {
-    int total = 0;
-
-    // Contar quantas transações há
-    for (int i = 0; i < TABLE_SIZE; i++) {
-        Transaction* t = hash_table[i];
-        while (t) {
-            total++;
-            t = t->next;
-        }
-    }
+    // A tabela ja conhece a quantidade de transacoes
+    int total = (int)hash_table.quantidade;
 
     if (total == 0) {
         printf("Nenhuma transacao encontrada.\n");
@@ -368,12 +577,9 @@ void ordenar_transacoes() {
     Transaction** lista = (Transaction**)malloc(total * sizeof(Transaction*));
     int idx = 0;
 
-    for (int i = 0; i < TABLE_SIZE; i++) {
-        Transaction* t = hash_table[i];
-        while (t) {
-            lista[idx++] = t;
-            t = t->next;
-        }
+    IteradorHash it;
+    for (Transaction* t = primeira_transacao(&it); t; t = proxima_transacao(&it)) {
+        lista[idx++] = t;
     }
 
     qsort(lista, total, sizeof(Transaction*), compare_transactions);
@@ -400,7 +606,10 @@ bool prever_fraude(Transaction* t) {
 
 int main() {
     // Carregar dados do arquivo CSV
-    load_csv("C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv");
+    const char* caminho = "C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv";
+    init_hash_table();
+    iniciar_filtros_contas(fdb_estimar_linhas(caminho));
+    load_csv(caminho);
 
     int opcao;
     char id[16];
@@ -415,6 +624,7 @@ int main() {
         printf("6. Agrupar por campo\n");
 		printf("7. Filtrar transacoes\n");
         printf("8. Ordenar transacoes por valor\n");
+        printf("9. Estatisticas da tabela hash\n");
         printf("Escolha uma opcao: ");
         scanf("%d", &opcao);
         getchar();
@@ -535,11 +745,17 @@ int main() {
             ordenar_transacoes();
             break;
 
+            case 9:
+            estatisticas_tabela();
+            break;
+
             default:
                 printf("Opcao invalida.\n");
         }
 
     } while (opcao != 4);
 
+    bloom_liberar(&filtro_remetentes);
+    bloom_liberar(&filtro_destinatarios);
     return 0;
 }
\ No newline at end of file
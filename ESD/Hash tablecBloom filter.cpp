@@ -3,36 +3,60 @@
 #include <string.h>
 #include <stdbool.h>
 #include <math.h>
-
-#define TABLE_SIZE 10007
-#define BLOOM_SIZE 1000000
+#include "leitor_csv.h"
+#include "snapshot_fdb.h"
+#include "hash_rapido.h"
+#include "codec_id.h"
+#include "filtro_bloom.h"
+#include "filtro_fuse.h"
+
+#define TABLE_SIZE (1 << 14)  // Potencia de 2: o balde sai por mascara
+#define BLOOM_FPR_ALVO 0.01   // Falsos positivos desejados no dimensionamento
+#define BLOOM_FPR_LIMITE 0.02 // Acima disso (estimado) o filtro e reconstruido
+#define BLOOM_FOLGA 2         // Capacidade da reconstrucao: chaves presentes * folga
+#define BLOOM_CHAVES_MINIMAS 1024
+#define BLOOM_AMOSTRA_FPR 100000
+
+// 1: replay somente leitura do dataset. Insercoes e remocoes ficam desligadas
+// e o filtro de Bloom da lugar a um filtro fuse imutavel (filtro_fuse.h),
+// construido depois do load_csv e gravado ao lado do dataset (.fuse)
+#ifndef SOMENTE_LEITURA
+#define SOMENTE_LEITURA 0
+#endif
 
 // === Bloom Filter ===
-unsigned char bloom[BLOOM_SIZE];
-
-unsigned int hash1(const char *str) {
-    unsigned int hash = 5381;
-    int c;
-    while ((c = *str++))
-        hash = ((hash << 5) + hash) + c;
-    return hash % BLOOM_SIZE;
+// Filtro bloqueado (filtro_bloom.h) com contadores de 4 bits, para que as
+// remocoes apaguem os bits; dimensionado pelas linhas do dataset
+FiltroBloom filtro;
+int reconstrucoes_filtro = 0;
+
+bool iniciar_filtro(FiltroBloom* f, size_t chaves) {
+    if (!bloom_iniciar(f, chaves > BLOOM_CHAVES_MINIMAS ? chaves : BLOOM_CHAVES_MINIMAS, BLOOM_FPR_ALVO))
+        return false;
+    if (!bloom_ativar_contagem(f)) {
+        bloom_liberar(f);
+        return false;
+    }
+    bloom_definir_limite(f, BLOOM_FPR_LIMITE);
+    return true;
 }
 
-unsigned int hash2(const char *str) {
-    unsigned int hash = 0;
-    int c;
-    while ((c = *str++))
-        hash = c + (hash << 6) + (hash << 16) - hash;
-    return hash % BLOOM_SIZE;
+// O filtro usa outra semente que a tabela, para as posicoes nao dependerem do balde
+void bloom_add(uint64_t chave) {
+    bloom_inserir(&filtro, codec_id_hash(chave, 1));
 }
 
-void bloom_add(const char* str) {
-    bloom[hash1(str)] = 1;
-    bloom[hash2(str)] = 1;
+void bloom_remove(uint64_t chave) {
+    bloom_remover(&filtro, codec_id_hash(chave, 1));
 }
 
-bool bloom_check(const char* str) {
-    return bloom[hash1(str)] && bloom[hash2(str)];
+// === Filtro fuse (somente leitura) ===
+FiltroFuse filtro_fixo;
+
+// Consulta o filtro ativo: o fuse no modo somente leitura, o Bloom no normal
+bool filtro_check(uint64_t chave) {
+    if (SOMENTE_LEITURA) return fuse_contem(&filtro_fixo, chave);
+    return bloom_contem(&filtro, codec_id_hash(chave, 1));
 }
 
 // === Hash Table Structures ===
@@ -47,21 +71,35 @@ typedef struct Transaction {
     char location[32];
     char device_used[16];
     bool is_fraud;
+    uint64_t chave; // transaction_id codificado (codec_id.h), preenchido na insercao
     struct Transaction* next;
 } Transaction;
 
 Transaction* hash_table[TABLE_SIZE];
 
-unsigned int hash(const char* str) {
-    unsigned int hash = 5381;
-    int c;
-    while ((c = *str++))
-        hash = ((hash << 5) + hash) + c;
-    return hash % TABLE_SIZE;
+// Refaz o filtro a partir das chaves da tabela quando a taxa estimada passa do
+// limite (tabela cresceu alem do previsto ou contadores saturaram)
+void reconstruir_filtro() {
+    FiltroBloom novo;
+    if (!iniciar_filtro(&novo, filtro.inseridos * BLOOM_FOLGA)) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        exit(1);
+    }
+    for (int i = 0; i < TABLE_SIZE; i++)
+        for (Transaction* t = hash_table[i]; t; t = t->next)
+            bloom_inserir(&novo, codec_id_hash(t->chave, 1));
+    bloom_liberar(&filtro);
+    filtro = novo;
+    reconstrucoes_filtro++;
+}
+
+unsigned int hash(uint64_t chave) {
+    return (unsigned int)hash_balde(codec_id_hash(chave, 0), TABLE_SIZE);
 }
 //Inserção de transação 
 void insert_transaction(Transaction t) {
-    unsigned int index = hash(t.transaction_id);
+    t.chave = codec_id_codificar(t.transaction_id);
+    unsigned int index = hash(t.chave);
     Transaction* new_node = (Transaction*)malloc(sizeof(Transaction));
     if (!new_node) {
         fprintf(stderr, "Erro de alocacao de memoria.\n");
@@ -71,19 +109,22 @@ void insert_transaction(Transaction t) {
     new_node->next = hash_table[index];
     hash_table[index] = new_node;
 
-    // Adiciona ao Bloom Filter
-    bloom_add(t.transaction_id);
+    // Adiciona ao Bloom Filter (no modo somente leitura o fuse e montado depois da carga)
+    if (SOMENTE_LEITURA) return;
+    bloom_add(t.chave);
+    if (bloom_precisa_reconstruir(&filtro)) reconstruir_filtro();
 }
 //Busca de transação por ID
 Transaction* search_transaction(const char* transaction_id) {
-    if (!bloom_check(transaction_id)) {
+    uint64_t chave = codec_id_codificar(transaction_id);
+    if (!filtro_check(chave)) {
         return NULL; 
     }
 
-    unsigned int index = hash(transaction_id);
+    unsigned int index = hash(chave);
     Transaction* current = hash_table[index];
     while (current) {
-        if (strcmp(current->transaction_id, transaction_id) == 0)
+        if (codec_id_iguais(current->chave, current->transaction_id, chave, transaction_id))
             return current;
         current = current->next;
     }
@@ -91,21 +132,23 @@ Transaction* search_transaction(const char* transaction_id) {
 }
 //Remoção de transação por ID
 void remove_transaction(const char* transaction_id) {
-    if (!bloom_check(transaction_id)) {
+    uint64_t chave = codec_id_codificar(transaction_id);
+    if (!filtro_check(chave)) {
         printf("Transacao %s nao encontrada (Bloom Filter).\n", transaction_id);
         return;
     }
 
-    unsigned int index = hash(transaction_id);
+    unsigned int index = hash(chave);
     Transaction* current = hash_table[index];
     Transaction* prev = NULL;
 
     while (current) {
-        if (strcmp(current->transaction_id, transaction_id) == 0) {
+        if (codec_id_iguais(current->chave, current->transaction_id, chave, transaction_id)) {
             if (prev)
                 prev->next = current->next;
             else
                 hash_table[index] = current->next;
+            bloom_remove(current->chave);
             free(current);
             printf("Transacao %s removida.\n", transaction_id);
             return;
@@ -115,34 +158,68 @@ void remove_transaction(const char* transaction_id) {
     }
     printf("Transacao %s nao encontrada.\n", transaction_id);
 }
+//Conversao de uma linha do CSV para Transaction
+bool converter_linha(const LinhaCSV* linha, void* destino) {
+    Transaction* t = (Transaction*)destino;
+    if (!csv_linha_completa(linha)) return false;
+    CSV_COPIAR(t->transaction_id, linha->campos[CAMPO_ID]);
+    CSV_COPIAR(t->timestamp, linha->campos[CAMPO_TIMESTAMP]);
+    CSV_COPIAR(t->sender_account, linha->campos[CAMPO_SENDER]);
+    CSV_COPIAR(t->receiver_account, linha->campos[CAMPO_RECEIVER]);
+    t->amount = csv_linha_amount(linha);
+    CSV_COPIAR(t->transaction_type, linha->campos[CAMPO_TIPO]);
+    CSV_COPIAR(t->merchant_category, linha->campos[CAMPO_CATEGORIA]);
+    CSV_COPIAR(t->location, linha->campos[CAMPO_LOCAL]);
+    CSV_COPIAR(t->device_used, linha->campos[CAMPO_DISPOSITIVO]);
+    t->is_fraud = csv_campo_fraude(linha->campos[CAMPO_FRAUDE]);
+    return true;
+}
+
+void inserir_registro(void* registro, void* contexto) {
+    (void)contexto;
+    insert_transaction(*(Transaction*)registro);
+}
+
 //Leitura do Dataset
 void load_csv(const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
+    if (!fdb_carregar_ou_gerar(filename, sizeof(Transaction), converter_linha, inserir_registro, NULL, CSV_THREADS_AUTO)) {
         perror("Erro ao abrir o arquivo");
         exit(1);
     }
+}
 
-    char line[512];
-    fgets(line, sizeof(line), file); // Pula cabeçalho
-
-    while (fgets(line, sizeof(line), file)) {
-        Transaction t;
-        char is_fraud_str[6];
-
-        int campos_lidos = sscanf(line, "%15[^,],%31[^,],%31[^,],%31[^,],%f,%15[^,],%31[^,],%31[^,],%15[^,],%5[^,\n]",
-               t.transaction_id, t.timestamp, t.sender_account, t.receiver_account, &t.amount,
-               t.transaction_type, t.merchant_category, t.location, t.device_used, is_fraud_str);
+// Monta o filtro fuse com as chaves carregadas. Reaproveita o .fuse gravado
+// se ele for do mesmo CSV e tiver saido do mesmo numero de transacoes (IDs
+// repetidos contam todos, como nas cadeias); senao constroi e grava
+void preparar_filtro_fixo(const char* caminho_csv) {
+    size_t quantidade = 0;
+    for (int i = 0; i < TABLE_SIZE; i++)
+        for (Transaction* t = hash_table[i]; t; t = t->next) quantidade++;
+
+    char caminho_fuse[1024];
+    uint64_t tamanho_csv = 0;
+    int64_t modificacao_csv = 0;
+    bool tem_caminho = fdb_caminho_derivado(caminho_csv, ".fuse", caminho_fuse, sizeof(caminho_fuse)) &&
+                       fdb_info_csv(caminho_csv, &tamanho_csv, &modificacao_csv);
+    if (tem_caminho && fuse_carregar(&filtro_fixo, caminho_fuse, tamanho_csv, modificacao_csv, (uint32_t)quantidade))
+        return;
 
-        if (campos_lidos == 10) {
-            t.is_fraud = strcmp(is_fraud_str, "True") == 0;
-            insert_transaction(t);
-        } else {
-            fprintf(stderr, "Linha ignorada por formato invalido: %s", line);
-        }
+    uint64_t* chaves = (uint64_t*)malloc((quantidade + 1) * sizeof(uint64_t));
+    if (!chaves) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        exit(1);
     }
-
-    fclose(file);
+    size_t n = 0;
+    for (int i = 0; i < TABLE_SIZE; i++)
+        for (Transaction* t = hash_table[i]; t; t = t->next) chaves[n++] = t->chave;
+    bool ok = fuse_construir(&filtro_fixo, chaves, n);
+    free(chaves);
+    if (!ok) {
+        fprintf(stderr, "Erro ao construir o filtro fuse.\n");
+        exit(1);
+    }
+    if (tem_caminho && !fuse_gravar(&filtro_fixo, caminho_fuse, tamanho_csv, modificacao_csv, (uint32_t)quantidade))
+        fprintf(stderr, "Aviso: nao foi possivel gravar %s\n", caminho_fuse);
 }
 
 int compare_floats(const void* a, const void* b) {
@@ -416,9 +493,50 @@ void ordenar_transacoes() {
 
     free(lista);
 }
+// Tamanho do filtro e taxa de falsos positivos esperada x medida com IDs ausentes
+void estatisticas_filtro() {
+    if (SOMENTE_LEITURA) {
+        printf("\n=== FILTRO FUSE (SOMENTE LEITURA) ===\n");
+        printf("Impressoes de 8 bits: %u (%.2f KB)\n", filtro_fixo.tamanho, fuse_memoria(&filtro_fixo) / 1024.0);
+        printf("Bits por chave: %.2f | segmentos: %u de %u posicoes | chaves: %u\n",
+               filtro_fixo.num_chaves ? filtro_fixo.tamanho * 8.0 / filtro_fixo.num_chaves : 0.0,
+               filtro_fixo.num_segmentos + FUSE_ARIDADE - 1, filtro_fixo.tamanho_segmento, filtro_fixo.num_chaves);
+        printf("Falsos positivos esperados: %.4f%% (1/256)\n", 100.0 / 256);
+    } else {
+        printf("\n=== FILTRO DE BLOOM ===\n");
+        printf("Blocos de 64 bytes: %u (%.2f KB com os contadores)\n", filtro.num_blocos, bloom_memoria(&filtro) / 1024.0);
+        printf("Bits por chave: %.2f | k: %d | chaves inseridas: %zu\n",
+               filtro.inseridos ? filtro.num_blocos * (double)BLOOM_BITS_BLOCO / filtro.inseridos : 0.0, filtro.k, filtro.inseridos);
+        printf("Bits ligados: %.2f%% | contadores saturados: %zu | reconstrucoes: %d\n",
+               filtro.bits_ligados * 100.0 / ((double)filtro.num_blocos * BLOOM_BITS_BLOCO), filtro.saturados, reconstrucoes_filtro);
+        printf("Falsos positivos esperados: %.4f%% (limite para reconstruir: %.2f%%)\n",
+               bloom_fpr_estimada(&filtro) * 100.0, BLOOM_FPR_LIMITE * 100.0);
+    }
+
+    size_t testados = 0, falsos = 0;
+    char id[16];
+    for (int i = 0; i < BLOOM_AMOSTRA_FPR; i++) {
+        snprintf(id, sizeof(id), "AUSENTE%d", i);
+        uint64_t chave = codec_id_codificar(id);
+        bool positivo = filtro_check(chave);
+        Transaction* t = hash_table[hash(chave)];
+        while (t && !codec_id_iguais(t->chave, t->transaction_id, chave, id)) t = t->next;
+        if (t) continue; // Inserido pelo usuario: nao e ausente
+        testados++;
+        if (positivo) falsos++;
+    }
+    printf("Falsos positivos medidos: %.4f%% (%zu de %zu IDs ausentes)\n",
+           testados ? falsos * 100.0 / testados : 0.0, falsos, testados);
+}
 // === MAIN ===
 int main() {
-    load_csv("C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv");
+    const char* caminho = "C:\\Users\\leozi\\OneDrive\\Desktop\\TrabalhoESD.csv\\financial_fraud_detection_dataset.csv";
+    if (!SOMENTE_LEITURA && !iniciar_filtro(&filtro, fdb_estimar_linhas(caminho))) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        return 1;
+    }
+    load_csv(caminho);
+    if (SOMENTE_LEITURA) preparar_filtro_fixo(caminho);
 
     int opcao;
     char id[16];
@@ -433,6 +551,7 @@ int main() {
         printf("6. Agrupar por campo\n");
         printf("7. Filtrar transacoes\n");
         printf("8. Ordenar transacoes por valor\n");
+        printf(SOMENTE_LEITURA ? "9. Estatisticas do filtro fuse\n" : "9. Estatisticas do filtro de Bloom\n");
         printf("Escolha uma opcao: ");
         scanf("%d", &opcao);
         getchar();
@@ -459,6 +578,10 @@ int main() {
                 break;
 
             case 2:
+                if (SOMENTE_LEITURA) {
+                    printf("Remocao indisponivel no modo somente leitura.\n");
+                    break;
+                }
                 printf("Digite o transaction_id para remover: ");
                 fgets(id, sizeof(id), stdin);
                 id[strcspn(id, "\n")] = '\0';
@@ -466,6 +589,10 @@ int main() {
                 break;
 
             case 3: {
+                if (SOMENTE_LEITURA) {
+                    printf("Insercao indisponivel no modo somente leitura.\n");
+                    break;
+                }
                 Transaction nova;
                 char is_fraud_str[6];
 
@@ -551,10 +678,18 @@ int main() {
             ordenar_transacoes();
             break;
 
+            case 9:
+            estatisticas_filtro();
+            break;
+
             default:
                 printf("Opcao invalida.\n");
         }
     } while (opcao != 4);
 
+    if (SOMENTE_LEITURA)
+        fuse_liberar(&filtro_fixo);
+    else
+        bloom_liberar(&filtro);
     return 0;
 }
\ No newline at end of file
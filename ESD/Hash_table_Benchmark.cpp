@@ -8,6 +8,8 @@
 #include <stdint.h>
 #include <windows.h> // Necessario para HighPrecisionTimer e Sleep
 #include <time.h>    // Necessario para srand, time
+#include <stddef.h>  // offsetof
+#include "tabela_swiss.h"
 
 #ifdef _MSC_VER
 #define _CRT_SECURE_NO_WARNINGS
@@ -156,6 +158,29 @@ void remove_transaction(HashTable* ht, const char* transaction_id) {
     }
 }
 
+// ================= TABELA SWISS (ENDERECAMENTO ABERTO) =================
+
+// Mesma interface da tabela encadeada; as transacoes ficam num array denso
+// e a tabela guarda so 1 byte de controle + 1 indice por slot.
+void init_swiss_table(TabelaSwiss* st) {
+    swiss_iniciar(st, sizeof(Transaction), offsetof(Transaction, transaction_id));
+}
+
+void free_swiss_table(TabelaSwiss* st) {
+    swiss_liberar(st);
+}
+
+void insert_transaction_swiss(TabelaSwiss* st, Transaction t) {
+    swiss_inserir(st, &t);
+}
+
+Transaction* search_transaction_swiss(TabelaSwiss* st, const char* transaction_id) {
+    return (Transaction*)swiss_buscar(st, transaction_id);
+}
+
+void remove_transaction_swiss(TabelaSwiss* st, const char* transaction_id) {
+    swiss_remover(st, transaction_id);
+}
 
 // ================= FUNCOES AUXILIARES PARA ESTATISTICAS =================
 
@@ -205,26 +230,31 @@ double stop_timer(HighPrecisionTimer* timer) {
     return elapsed;
 }
 
+// Preenche uma transacao aleatoria com transaction_id unico para o indice i
+void generateRandomTransaction(Transaction* d, int i) {
+    memset(d, 0, sizeof(*d));
+    // Gera transaction_id unico como string
+    snprintf(d->transaction_id, sizeof(d->transaction_id), "TRN%08d%04d", i, rand() % 10000); 
+    
+    snprintf(d->timestamp, sizeof(d->timestamp), "2024-01-01 %02d:%02d:%02d", rand() % 24, rand() % 60, rand() % 60);
+    snprintf(d->sender_account, sizeof(d->sender_account), "ACC%05d", rand() % 100000);
+    snprintf(d->receiver_account, sizeof(d->receiver_account), "ACC%05d", rand() % 100000);
+    d->amount = 10.0f + (rand() % 10000) / 100.0f;
+    char types[][16] = {"purchase", "transfer", "deposit", "withdrawal", "payment"};
+    snprintf(d->transaction_type, sizeof(d->transaction_type), "%s", types[rand() % 5]);
+    char categories[][32] = {"retail", "food", "travel", "online", "services", "utilities", "healthcare"};
+    snprintf(d->merchant_category, sizeof(d->merchant_category), "%s", categories[rand() % 7]);
+    snprintf(d->location, sizeof(d->location), "City%03d", rand() % 500);
+    char devices[][16] = {"mobile", "web", "pos", "atm"};
+    snprintf(d->device_used, sizeof(d->device_used), "%s", devices[rand() % 4]);
+    d->is_fraud = (rand() % 100 < 5); // 5% de chance de ser fraude
+}
+
 // Gera dados aleatorios e os insere na HashTable
 void generateRandomDataForHash(HashTable* ht, int count) {
     for (int i = 0; i < count; i++) {
-        Transaction d = {0}; 
-        // Gera transaction_id unico como string
-        snprintf(d.transaction_id, sizeof(d.transaction_id), "TRN%08d%04d", i, rand() % 10000); 
-        
-        snprintf(d.timestamp, sizeof(d.timestamp), "2024-01-01 %02d:%02d:%02d", rand() % 24, rand() % 60, rand() % 60);
-        snprintf(d.sender_account, sizeof(d.sender_account), "ACC%05d", rand() % 100000);
-        snprintf(d.receiver_account, sizeof(d.receiver_account), "ACC%05d", rand() % 100000);
-        d.amount = 10.0f + (rand() % 10000) / 100.0f;
-        char types[][16] = {"purchase", "transfer", "deposit", "withdrawal", "payment"};
-        snprintf(d.transaction_type, sizeof(d.transaction_type), "%s", types[rand() % 5]);
-        char categories[][32] = {"retail", "food", "travel", "online", "services", "utilities", "healthcare"};
-        snprintf(d.merchant_category, sizeof(d.merchant_category), "%s", categories[rand() % 7]);
-        snprintf(d.location, sizeof(d.location), "City%03d", rand() % 500);
-        char devices[][16] = {"mobile", "web", "pos", "atm"};
-        snprintf(d.device_used, sizeof(d.device_used), "%s", devices[rand() % 4]);
-        d.is_fraud = (rand() % 100 < 5); // 5% de chance de ser fraude
-
+        Transaction d;
+        generateRandomTransaction(&d, i);
         insert_transaction(ht, d);
     }
 }
@@ -564,6 +594,147 @@ void benchmark_combined_operations_hashtable(HashTable* ht) {
            mean, std_dev, cov);
 }
 
+// Operacoes medidas na comparacao entre encadeamento e Swiss table
+typedef enum {
+    OP_INSERCAO,
+    OP_BUSCA,
+    OP_BUSCA_AUSENTE,
+    OP_REMOCAO
+} OperacaoComparacao;
+
+// Tempo de uma repeticao da operacao na tabela encadeada. "ht" ja vem
+// preenchida com "dados" para busca; insercao e remocao montam a propria.
+double measure_chaining(OperacaoComparacao op, HashTable* ht, Transaction* dados, int n,
+                        char (*consultas)[16], int num_consultas) {
+    HighPrecisionTimer t;
+    HashTable tmp;
+    double elapsed = 0.0;
+    volatile int found = 0;
+
+    switch (op) {
+        case OP_INSERCAO:
+            init_hash_table(&tmp);
+            start_timer(&t);
+            for (int j = 0; j < n; j++) insert_transaction(&tmp, dados[j]);
+            elapsed = stop_timer(&t);
+            free_hash_table(&tmp);
+            break;
+        case OP_BUSCA:
+        case OP_BUSCA_AUSENTE:
+            start_timer(&t);
+            for (int j = 0; j < num_consultas; j++)
+                if (search_transaction(ht, consultas[j])) found++;
+            elapsed = stop_timer(&t);
+            break;
+        case OP_REMOCAO:
+            init_hash_table(&tmp);
+            for (int j = 0; j < n; j++) insert_transaction(&tmp, dados[j]);
+            start_timer(&t);
+            for (int j = 0; j < num_consultas; j++) remove_transaction(&tmp, consultas[j]);
+            elapsed = stop_timer(&t);
+            free_hash_table(&tmp);
+            break;
+    }
+    return elapsed;
+}
+
+// Mesma medicao na Swiss table
+double measure_swiss(OperacaoComparacao op, TabelaSwiss* st, Transaction* dados, int n,
+                     char (*consultas)[16], int num_consultas) {
+    HighPrecisionTimer t;
+    TabelaSwiss tmp;
+    double elapsed = 0.0;
+    volatile int found = 0;
+
+    switch (op) {
+        case OP_INSERCAO:
+            init_swiss_table(&tmp);
+            start_timer(&t);
+            for (int j = 0; j < n; j++) insert_transaction_swiss(&tmp, dados[j]);
+            elapsed = stop_timer(&t);
+            free_swiss_table(&tmp);
+            break;
+        case OP_BUSCA:
+        case OP_BUSCA_AUSENTE:
+            start_timer(&t);
+            for (int j = 0; j < num_consultas; j++)
+                if (search_transaction_swiss(st, consultas[j])) found++;
+            elapsed = stop_timer(&t);
+            break;
+        case OP_REMOCAO:
+            init_swiss_table(&tmp);
+            for (int j = 0; j < n; j++) insert_transaction_swiss(&tmp, dados[j]);
+            start_timer(&t);
+            for (int j = 0; j < num_consultas; j++) remove_transaction_swiss(&tmp, consultas[j]);
+            elapsed = stop_timer(&t);
+            free_swiss_table(&tmp);
+            break;
+    }
+    return elapsed;
+}
+
+// Compara a tabela encadeada com a Swiss table sobre os mesmos dados
+void benchmark_chaining_vs_swiss() {
+    printf("\nBenchmark Encadeamento x Swiss Table (mesmos dados e consultas):\n");
+    int sizes[] = {10000, 100000, 500000};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    const int num_consultas = 10000;
+    const char* nomes_op[] = {"Insercao", "Busca (presente)", "Busca (ausente)", "Remocao"};
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        Transaction* dados = (Transaction*)malloc(n * sizeof(Transaction));
+        char (*presentes)[16] = (char (*)[16])malloc(num_consultas * 16);
+        char (*ausentes)[16] = (char (*)[16])malloc(num_consultas * 16);
+        if (!dados || !presentes || !ausentes) {
+            perror("Falha ao alocar memoria para a comparacao");
+            free(dados); free(presentes); free(ausentes);
+            return;
+        }
+        for (int i = 0; i < n; i++) generateRandomTransaction(&dados[i], i);
+        for (int j = 0; j < num_consultas; j++) {
+            strcpy(presentes[j], dados[(((unsigned long long)rand() << 15) ^ (unsigned long long)rand()) % n].transaction_id);
+            snprintf(ausentes[j], sizeof(ausentes[j]), "MIS%08d%04d", j, rand() % 10000);
+        }
+
+        HashTable ht;
+        TabelaSwiss st;
+        init_hash_table(&ht);
+        init_swiss_table(&st);
+        for (int i = 0; i < n; i++) {
+            insert_transaction(&ht, dados[i]);
+            insert_transaction_swiss(&st, dados[i]);
+        }
+
+        printf("\n  Tamanho: %d elementos\n", n);
+        for (int op = OP_INSERCAO; op <= OP_REMOCAO; op++) {
+            char (*consultas)[16] = op == OP_BUSCA_AUSENTE ? ausentes : presentes;
+            double results_chaining[NUM_REPETITIONS], results_swiss[NUM_REPETITIONS];
+            for (int i = 0; i < NUM_REPETITIONS; i++) {
+                results_chaining[i] = measure_chaining((OperacaoComparacao)op, &ht, dados, n, consultas, num_consultas);
+                results_swiss[i] = measure_swiss((OperacaoComparacao)op, &st, dados, n, consultas, num_consultas);
+            }
+            double mean_c = calculate_mean(results_chaining, NUM_REPETITIONS);
+            double std_c = calculate_std_dev(results_chaining, NUM_REPETITIONS, mean_c);
+            double mean_s = calculate_mean(results_swiss, NUM_REPETITIONS);
+            double std_s = calculate_std_dev(results_swiss, NUM_REPETITIONS, mean_s);
+            printf("    %-17s | Encadeamento: %8.3f ms (CV %5.2f%%) | Swiss: %8.3f ms (CV %5.2f%%) | %.2fx\n",
+                   nomes_op[op], mean_c, calculate_coeff_of_variation(mean_c, std_c),
+                   mean_s, calculate_coeff_of_variation(mean_s, std_s), mean_s > 0 ? mean_c / mean_s : 0.0);
+        }
+
+        size_t memoria_c = ht.size * sizeof(Transaction) + ht.capacity * sizeof(Transaction*) + sizeof(HashTable);
+        printf("    %-17s | Encadeamento: %8.2f KB | Swiss: %8.2f KB (%zu slots, carga %.2f)\n", "Memoria",
+               memoria_c / 1024.0, swiss_memoria(&st) / 1024.0, st.capacidade, (double)st.quantidade / st.capacidade);
+
+        free_hash_table(&ht);
+        free_swiss_table(&st);
+        free(dados);
+        free(presentes);
+        free(ausentes);
+    }
+}
+
 // Executa todos os benchmarks completos para a HashTable
 void run_all_benchmarks_hashtable(HashTable* ht_ptr) { 
     printf("\n===========================================\n");
@@ -601,6 +772,9 @@ void run_all_benchmarks_hashtable(HashTable* ht_ptr) {
     printf("\n7. Latencia Media (operacoes combinadas):\n"); 
     benchmark_combined_operations_hashtable(ht_ptr); 
 
+    printf("\n8. Encadeamento x Swiss Table:\n"); 
+    benchmark_chaining_vs_swiss();
+
     printf("\n===========================================\n");
     printf("=== BENCHMARKS CONCLUIDOS ===\n"); 
     printf("===========================================\n");
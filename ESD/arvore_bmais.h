@@ -0,0 +1,533 @@
+// Arvore B+ sobre pares (chave de 64 bits, valor de 32 bits), ordenados pela
+// chave e, em empate, pelo valor. O par inteiro e unico, entao a mesma chave
+// pode aparecer com valores diferentes: com o valor sendo o indice de um
+// registro, a arvore serve de indice para chaves repetidas (um valor de
+// transacao, uma chave com colisao de hash) sem caso especial.
+//
+// Os nos tem um tamanho fixo em bytes escolhido em bmais_iniciar (multiplo de
+// 64 para ficar alinhado as linhas de cache do pool; 4096 para uma pagina) e
+// a capacidade sai dele: um no de 256 bytes guarda 14 pares. Com dezenas de
+// pares por no a altura fica em 4 ou 5 para milhoes de chaves, contra mais de
+// 20 niveis da AVL, e cada nivel custa poucas linhas vizinhas em vez de uma
+// falta de cache por no. Ao descer, as primeiras linhas do filho sao pedidas
+// ao processador antes da busca binaria comecar.
+//
+// Todos os pares ficam nas folhas, encadeadas em ordem: um intervalo e uma
+// descida ate a primeira chave e depois so leitura sequencial (CursorBMais).
+// Os nos internos guardam copias de pares como separadores; um separador pode
+// continuar la depois que o par sai da folha, o que nao atrapalha a ordem.
+//
+// Os nos ficam num pool_indices.h e se referenciam por indices (0 = nenhum);
+// ponteiros para nos valem ate a proxima insercao.
+#ifndef ARVORE_BMAIS_H
+#define ARVORE_BMAIS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "pool_indices.h"
+#include "cursor_arvore.h"
+
+#define BMAIS_CABECALHO 8            // Bytes de NoBMais antes das chaves
+#define BMAIS_MIN_CAPACIDADE 4
+#define BMAIS_MAX_CAPACIDADE 4096
+#define BMAIS_MAX_ALTURA 32          // Com no minimo 3 filhos por no, mais que 2^32 pares
+#define BMAIS_LINHA 64
+#define BMAIS_PREFETCH_LINHAS 4      // Linhas de chaves pedidas por no ao descer
+
+typedef struct ParBMais {
+    uint64_t chave;
+    uint32_t valor;
+} ParBMais;
+
+// Cabecalho de um no; logo depois vem chaves[capacidade + 1], filhos
+// [capacidade + 2] (so nos internos) e valores[capacidade + 1]. A descida le
+// as chaves e um filho, que ficam juntos; o valor so e lido em empate de
+// chaves e na folha. O par e o filho a mais deixam inserir antes de dividir
+typedef struct NoBMais {
+    uint16_t quantidade;         // Pares (folha) ou separadores (interno)
+    uint16_t folha;
+    uint32_t proxima;            // Folha seguinte em ordem (0 = ultima)
+} NoBMais;
+
+typedef struct ArvoreBMais {
+    PoolIndices nos;
+    uint32_t raiz;               // 0 = arvore vazia
+    uint32_t altura;             // Niveis; 1 = so a raiz folha
+    uint32_t capacidade;         // Pares por no
+    uint32_t minimo;             // Pares de um no que nao e a raiz
+    size_t tamanho;
+    size_t deslocamento_valores;
+    size_t deslocamento_filhos;
+} ArvoreBMais;
+
+typedef struct CursorBMais {
+    const ArvoreBMais* a;
+    uint32_t folha;
+    int posicao;
+} CursorBMais;
+
+// ================= NOS =================
+
+static inline NoBMais* bmais_no(const ArvoreBMais* a, uint32_t i) {
+    return (NoBMais*)pool_item(&a->nos, i);
+}
+
+static inline uint64_t* bmais_chaves(const NoBMais* no) {
+    return (uint64_t*)((unsigned char*)no + BMAIS_CABECALHO);
+}
+
+static inline uint32_t* bmais_valores(const ArvoreBMais* a, const NoBMais* no) {
+    return (uint32_t*)((unsigned char*)no + a->deslocamento_valores);
+}
+
+static inline uint32_t* bmais_filhos(const ArvoreBMais* a, const NoBMais* no) {
+    return (uint32_t*)((unsigned char*)no + a->deslocamento_filhos);
+}
+
+static inline size_t bmais_tamanho_no(uint32_t capacidade) {
+    return BMAIS_CABECALHO + (capacidade + 1) * (sizeof(uint64_t) + sizeof(uint32_t)) + (capacidade + 2) * sizeof(uint32_t);
+}
+
+// "bytes_no" e o tamanho de cada no; a capacidade e a maior que cabe nele
+static inline void bmais_iniciar(ArvoreBMais* a, size_t bytes_no) {
+    uint32_t capacidade = BMAIS_MIN_CAPACIDADE;
+    while (capacidade < BMAIS_MAX_CAPACIDADE && bmais_tamanho_no(capacidade + 1) <= bytes_no) capacidade++;
+    size_t tamanho = bmais_tamanho_no(capacidade);
+    if (tamanho < bytes_no) tamanho = bytes_no;
+    tamanho = (tamanho + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1); // Chaves alinhadas em todo no
+    pool_iniciar(&a->nos, tamanho);
+    a->raiz = 0;
+    a->altura = 0;
+    a->capacidade = capacidade;
+    a->minimo = capacidade / 2;
+    a->tamanho = 0;
+    a->deslocamento_filhos = BMAIS_CABECALHO + (capacidade + 1) * sizeof(uint64_t);
+    a->deslocamento_valores = a->deslocamento_filhos + (capacidade + 2) * sizeof(uint32_t);
+}
+
+static inline void bmais_liberar(ArvoreBMais* a) {
+    pool_liberar(&a->nos);
+    a->raiz = 0;
+    a->altura = 0;
+    a->tamanho = 0;
+}
+
+static inline size_t bmais_memoria(const ArvoreBMais* a) {
+    return pool_memoria(&a->nos);
+}
+
+static inline uint32_t bmais_novo_no(ArvoreBMais* a, bool folha) {
+    uint32_t i = pool_alocar(&a->nos);
+    NoBMais* no = bmais_no(a, i);
+    no->quantidade = 0;
+    no->folha = folha;
+    no->proxima = 0;
+    return i;
+}
+
+// Pede ao processador as primeiras linhas do no: ele inteiro, se for pequeno,
+// ou o comeco das chaves, por onde a busca binaria comeca
+static inline void bmais_prefetch_no(const ArvoreBMais* a, uint32_t i) {
+    const unsigned char* no = (const unsigned char*)bmais_no(a, i);
+    for (size_t d = 0; d < a->nos.tamanho_item && d < BMAIS_PREFETCH_LINHAS * BMAIS_LINHA; d += BMAIS_LINHA)
+        CURSOR_PREFETCH(no + d);
+}
+
+// Move n pares (ou n filhos) de origem[j] para destino[i]; as faixas podem
+// se sobrepor
+static inline void bmais_mover_pares(const ArvoreBMais* a, NoBMais* destino, int i, const NoBMais* origem, int j, int n) {
+    memmove(bmais_chaves(destino) + i, bmais_chaves(origem) + j, n * sizeof(uint64_t));
+    memmove(bmais_valores(a, destino) + i, bmais_valores(a, origem) + j, n * sizeof(uint32_t));
+}
+
+static inline void bmais_mover_filhos(const ArvoreBMais* a, NoBMais* destino, int i, const NoBMais* origem, int j, int n) {
+    memmove(bmais_filhos(a, destino) + i, bmais_filhos(a, origem) + j, n * sizeof(uint32_t));
+}
+
+static inline void bmais_gravar_par(const ArvoreBMais* a, NoBMais* no, int i, uint64_t chave, uint32_t valor) {
+    bmais_chaves(no)[i] = chave;
+    bmais_valores(a, no)[i] = valor;
+}
+
+// ================= BUSCA NOS NOS =================
+
+// Quantos pares do no vem antes de (chave, valor): os menores ou, com
+// "inclusive", os menores ou iguais. A busca binaria so olha as chaves e nao
+// tem desvio no laco (cada passo escolhe a base da metade com um cmov, sem
+// erro de previsao); depois anda pelas chaves iguais comparando o valor, o
+// que com chaves unicas e no maximo um passo
+static inline int bmais_contar(const ArvoreBMais* a, const NoBMais* no, uint64_t chave, uint32_t valor, bool inclusive) {
+    const uint64_t* chaves = bmais_chaves(no);
+    int q = no->quantidade, base = 0, n = q;
+    if (n == 0) return 0;
+    while (n > 1) {
+        int metade = n / 2;
+        base = chaves[base + metade] < chave ? base + metade : base;
+        n -= metade;
+    }
+    base += chaves[base] < chave;
+    while (base < q && chaves[base] == chave) {
+        uint32_t v = bmais_valores(a, no)[base];
+        if (v > valor || (v == valor && !inclusive)) break;
+        base++;
+    }
+    return base;
+}
+
+// Primeira posicao do no com par >= (chave, valor)
+static inline int bmais_limite_inferior(const ArvoreBMais* a, const NoBMais* no, uint64_t chave, uint32_t valor) {
+    return bmais_contar(a, no, chave, valor, false);
+}
+
+// Filho de um no interno onde (chave, valor) estaria: quantos separadores
+// sao <= o par (cada separador e o menor par da subarvore a sua direita)
+static inline int bmais_posicao_filho(const ArvoreBMais* a, const NoBMais* no, uint64_t chave, uint32_t valor) {
+    return bmais_contar(a, no, chave, valor, true);
+}
+
+// Desce da raiz (nao vazia) ate a folha de (chave, valor). Se "caminho" nao
+// for NULL, anota os nos internos e o filho tomado em cada um, para a
+// insercao e a remocao subirem sem ponteiro para o pai
+static inline uint32_t bmais_descer(const ArvoreBMais* a, uint64_t chave, uint32_t valor,
+                                    uint32_t* caminho, int* posicoes, int* profundidade) {
+    uint32_t i = a->raiz;
+    int d = 0;
+    const NoBMais* no = bmais_no(a, i);
+    while (!no->folha) {
+        int p = bmais_posicao_filho(a, no, chave, valor);
+        if (caminho) {
+            caminho[d] = i;
+            posicoes[d] = p;
+        }
+        d++;
+        i = bmais_filhos(a, no)[p];
+        bmais_prefetch_no(a, i);
+        no = bmais_no(a, i);
+    }
+    if (profundidade) *profundidade = d;
+    return i;
+}
+
+// ================= INSERCAO =================
+
+// Divide uma folha cheia ao meio; devolve a nova folha (a direita) e o menor
+// par dela, que sobe como separador
+static inline uint32_t bmais_dividir_folha(ArvoreBMais* a, uint32_t i, ParBMais* separador) {
+    uint32_t n = bmais_novo_no(a, true);
+    NoBMais* no = bmais_no(a, i);
+    NoBMais* novo = bmais_no(a, n);
+    int fica = no->quantidade / 2;
+    int passa = no->quantidade - fica;
+    bmais_mover_pares(a, novo, 0, no, fica, passa);
+    novo->quantidade = (uint16_t)passa;
+    no->quantidade = (uint16_t)fica;
+    novo->proxima = no->proxima;
+    no->proxima = n;
+    separador->chave = bmais_chaves(novo)[0];
+    separador->valor = bmais_valores(a, novo)[0];
+    return n;
+}
+
+// Divide um no interno cheio: o separador do meio sobe e a metade direita
+// (separadores e filhos) vai para o novo no
+static inline uint32_t bmais_dividir_interno(ArvoreBMais* a, uint32_t i, ParBMais* separador) {
+    uint32_t n = bmais_novo_no(a, false);
+    NoBMais* no = bmais_no(a, i);
+    NoBMais* novo = bmais_no(a, n);
+    int meio = no->quantidade / 2;
+    int passa = no->quantidade - meio - 1;
+    separador->chave = bmais_chaves(no)[meio];
+    separador->valor = bmais_valores(a, no)[meio];
+    bmais_mover_pares(a, novo, 0, no, meio + 1, passa);
+    bmais_mover_filhos(a, novo, 0, no, meio + 1, passa + 1);
+    novo->quantidade = (uint16_t)passa;
+    no->quantidade = (uint16_t)meio;
+    return n;
+}
+
+// Insere o par; false se ele ja estava na arvore
+static inline bool bmais_inserir(ArvoreBMais* a, uint64_t chave, uint32_t valor) {
+    if (!a->raiz) {
+        a->raiz = bmais_novo_no(a, true);
+        NoBMais* raiz = bmais_no(a, a->raiz);
+        bmais_gravar_par(a, raiz, 0, chave, valor);
+        raiz->quantidade = 1;
+        a->altura = 1;
+        a->tamanho = 1;
+        return true;
+    }
+
+    uint32_t caminho[BMAIS_MAX_ALTURA];
+    int posicoes[BMAIS_MAX_ALTURA];
+    int d;
+    uint32_t atual = bmais_descer(a, chave, valor, caminho, posicoes, &d);
+    NoBMais* no = bmais_no(a, atual);
+    int i = bmais_limite_inferior(a, no, chave, valor);
+    if (i < no->quantidade && bmais_chaves(no)[i] == chave && bmais_valores(a, no)[i] == valor)
+        return false;
+    bmais_mover_pares(a, no, i + 1, no, i, no->quantidade - i);
+    bmais_gravar_par(a, no, i, chave, valor);
+    no->quantidade++;
+    a->tamanho++;
+    if (no->quantidade <= a->capacidade) return true;
+
+    // Divisoes de baixo para cima; alocar pode mover o pool, entao os nos
+    // sao relidos pelo indice a cada passo
+    ParBMais separador;
+    uint32_t novo = bmais_dividir_folha(a, atual, &separador);
+    while (d > 0) {
+        d--;
+        atual = caminho[d];
+        int p = posicoes[d];
+        no = bmais_no(a, atual);
+        bmais_mover_pares(a, no, p + 1, no, p, no->quantidade - p);
+        bmais_mover_filhos(a, no, p + 2, no, p + 1, no->quantidade - p);
+        bmais_gravar_par(a, no, p, separador.chave, separador.valor);
+        bmais_filhos(a, no)[p + 1] = novo;
+        no->quantidade++;
+        if (no->quantidade <= a->capacidade) return true;
+        novo = bmais_dividir_interno(a, atual, &separador);
+    }
+
+    // A raiz dividiu: a arvore ganha um nivel
+    uint32_t raiz = bmais_novo_no(a, false);
+    no = bmais_no(a, raiz);
+    bmais_gravar_par(a, no, 0, separador.chave, separador.valor);
+    bmais_filhos(a, no)[0] = atual;
+    bmais_filhos(a, no)[1] = novo;
+    no->quantidade = 1;
+    a->raiz = raiz;
+    a->altura++;
+    return true;
+}
+
+// ================= REMOCAO =================
+
+// Junta o filho k + 1 de "pai" no filho k e tira o separador entre eles
+static inline void bmais_juntar(ArvoreBMais* a, uint32_t pai, int k) {
+    NoBMais* p = bmais_no(a, pai);
+    uint32_t direita_i = bmais_filhos(a, p)[k + 1];
+    NoBMais* esquerda = bmais_no(a, bmais_filhos(a, p)[k]);
+    NoBMais* direita = bmais_no(a, direita_i);
+    int q = esquerda->quantidade;
+    if (esquerda->folha) {
+        bmais_mover_pares(a, esquerda, q, direita, 0, direita->quantidade);
+        esquerda->quantidade = (uint16_t)(q + direita->quantidade);
+        esquerda->proxima = direita->proxima;
+    } else {
+        // O separador desce e fica entre as duas metades
+        bmais_mover_pares(a, esquerda, q, p, k, 1);
+        bmais_mover_pares(a, esquerda, q + 1, direita, 0, direita->quantidade);
+        bmais_mover_filhos(a, esquerda, q + 1, direita, 0, direita->quantidade + 1);
+        esquerda->quantidade = (uint16_t)(q + 1 + direita->quantidade);
+    }
+    bmais_mover_pares(a, p, k, p, k + 1, p->quantidade - k - 1);
+    bmais_mover_filhos(a, p, k + 1, p, k + 2, p->quantidade - k - 1);
+    p->quantidade--;
+    pool_devolver(&a->nos, direita_i);
+}
+
+// O filho "k" de "pai" ficou abaixo do minimo: pega um par de um irmao que
+// tenha sobra ou, se nenhum tiver, junta-se a um deles
+static inline void bmais_rebalancear(ArvoreBMais* a, uint32_t pai, int k) {
+    NoBMais* p = bmais_no(a, pai);
+    uint32_t* filhos = bmais_filhos(a, p);
+    NoBMais* no = bmais_no(a, filhos[k]);
+    NoBMais* esquerda = k > 0 ? bmais_no(a, filhos[k - 1]) : NULL;
+    NoBMais* direita = k < p->quantidade ? bmais_no(a, filhos[k + 1]) : NULL;
+    int q = no->quantidade;
+
+    if (esquerda && esquerda->quantidade > a->minimo) {
+        int qe = esquerda->quantidade;
+        bmais_mover_pares(a, no, 1, no, 0, q);
+        if (no->folha) {
+            bmais_mover_pares(a, no, 0, esquerda, qe - 1, 1);
+            bmais_mover_pares(a, p, k - 1, no, 0, 1);
+        } else {
+            bmais_mover_filhos(a, no, 1, no, 0, q + 1);
+            bmais_mover_pares(a, no, 0, p, k - 1, 1);
+            bmais_filhos(a, no)[0] = bmais_filhos(a, esquerda)[qe];
+            bmais_mover_pares(a, p, k - 1, esquerda, qe - 1, 1);
+        }
+        esquerda->quantidade--;
+        no->quantidade++;
+    } else if (direita && direita->quantidade > a->minimo) {
+        int qd = direita->quantidade;
+        if (no->folha) {
+            bmais_mover_pares(a, no, q, direita, 0, 1);
+            bmais_mover_pares(a, direita, 0, direita, 1, qd - 1);
+            bmais_mover_pares(a, p, k, direita, 0, 1);
+        } else {
+            bmais_mover_pares(a, no, q, p, k, 1);
+            bmais_filhos(a, no)[q + 1] = bmais_filhos(a, direita)[0];
+            bmais_mover_pares(a, p, k, direita, 0, 1);
+            bmais_mover_pares(a, direita, 0, direita, 1, qd - 1);
+            bmais_mover_filhos(a, direita, 0, direita, 1, qd);
+        }
+        direita->quantidade--;
+        no->quantidade++;
+    } else if (esquerda) {
+        bmais_juntar(a, pai, k - 1);
+    } else {
+        bmais_juntar(a, pai, k);
+    }
+}
+
+// Remove o par; false se ele nao estava na arvore
+static inline bool bmais_remover(ArvoreBMais* a, uint64_t chave, uint32_t valor) {
+    if (!a->raiz) return false;
+
+    uint32_t caminho[BMAIS_MAX_ALTURA];
+    int posicoes[BMAIS_MAX_ALTURA];
+    int d;
+    uint32_t atual = bmais_descer(a, chave, valor, caminho, posicoes, &d);
+    NoBMais* no = bmais_no(a, atual);
+    int i = bmais_limite_inferior(a, no, chave, valor);
+    if (i >= no->quantidade || bmais_chaves(no)[i] != chave || bmais_valores(a, no)[i] != valor)
+        return false;
+    bmais_mover_pares(a, no, i, no, i + 1, no->quantidade - i - 1);
+    no->quantidade--;
+    a->tamanho--;
+
+    while (d > 0 && bmais_no(a, atual)->quantidade < a->minimo) {
+        d--;
+        bmais_rebalancear(a, caminho[d], posicoes[d]);
+        atual = caminho[d];
+    }
+
+    // Raiz vazia: a arvore perde um nivel (ou fica vazia)
+    NoBMais* raiz = bmais_no(a, a->raiz);
+    if (raiz->quantidade == 0) {
+        uint32_t antiga = a->raiz;
+        a->raiz = raiz->folha ? 0 : bmais_filhos(a, raiz)[0];
+        a->altura--;
+        pool_devolver(&a->nos, antiga);
+    }
+    return true;
+}
+
+// ================= CURSOR E BUSCA =================
+
+// Posiciona o cursor no primeiro par >= (chave, valor)
+static inline void bmais_cursor_desde(CursorBMais* c, const ArvoreBMais* a, uint64_t chave, uint32_t valor) {
+    c->a = a;
+    c->folha = 0;
+    c->posicao = 0;
+    if (!a->raiz) return;
+    c->folha = bmais_descer(a, chave, valor, NULL, NULL, NULL);
+    c->posicao = bmais_limite_inferior(a, bmais_no(a, c->folha), chave, valor);
+}
+
+static inline void bmais_primeiro(CursorBMais* c, const ArvoreBMais* a) {
+    bmais_cursor_desde(c, a, 0, 0);
+}
+
+// Proximo par em ordem; false no fim. Ao passar para uma folha, a seguinte
+// ja e pedida ao processador
+static inline bool bmais_proximo(CursorBMais* c, uint64_t* chave, uint32_t* valor) {
+    while (c->folha) {
+        const NoBMais* no = bmais_no(c->a, c->folha);
+        if (c->posicao < no->quantidade) {
+            *chave = bmais_chaves(no)[c->posicao];
+            if (valor) *valor = bmais_valores(c->a, no)[c->posicao];
+            c->posicao++;
+            return true;
+        }
+        c->folha = no->proxima;
+        c->posicao = 0;
+        if (c->folha) {
+            uint32_t seguinte = bmais_no(c->a, c->folha)->proxima;
+            if (seguinte) bmais_prefetch_no(c->a, seguinte);
+        }
+    }
+    return false;
+}
+
+// Valor do primeiro par com a chave (o de menor valor, se houver varios)
+static inline bool bmais_buscar(const ArvoreBMais* a, uint64_t chave, uint32_t* valor) {
+    CursorBMais c;
+    uint64_t achada;
+    uint32_t v;
+    bmais_cursor_desde(&c, a, chave, 0);
+    if (!bmais_proximo(&c, &achada, &v) || achada != chave) return false;
+    if (valor) *valor = v;
+    return true;
+}
+
+// ================= CONSTRUCAO EM LOTE =================
+
+// Monta a arvore (vazia) de uma vez a partir de n pares em ordem crescente e
+// sem repeticao. Os pares sao repartidos por igual entre o menor numero de
+// folhas que os comporta, e cada nivel acima da mesma forma, entao todo no
+// fica acima do minimo; O(n), sem divisoes nem buscas
+static inline void bmais_construir(ArvoreBMais* a, const ParBMais* pares, size_t n) {
+    if (n == 0) return;
+    size_t folhas = (n + a->capacidade - 1) / a->capacidade;
+    size_t total = 0;
+    for (size_t k = folhas;; k = (k + a->capacidade) / (a->capacidade + 1)) {
+        total += k;
+        if (k == 1) break;
+    }
+    if (total >= UINT32_MAX / 2) {
+        fprintf(stderr, "Erro: limite de itens do pool atingido.\n");
+        exit(1);
+    }
+    pool_reservar(&a->nos, a->nos.usados + (uint32_t)total);
+
+    // Indice de cada no do nivel atual e a posicao do seu menor par
+    uint32_t* nivel = (uint32_t*)malloc(folhas * sizeof(uint32_t));
+    size_t* primeiro = (size_t*)malloc(folhas * sizeof(size_t));
+    if (!nivel || !primeiro) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        exit(1);
+    }
+
+    size_t inicio = 0;
+    uint32_t anterior = 0;
+    for (size_t j = 0; j < folhas; j++) {
+        size_t quantidade = n / folhas + (j < n % folhas);
+        uint32_t i = bmais_novo_no(a, true);
+        NoBMais* no = bmais_no(a, i);
+        for (size_t k = 0; k < quantidade; k++)
+            bmais_gravar_par(a, no, (int)k, pares[inicio + k].chave, pares[inicio + k].valor);
+        no->quantidade = (uint16_t)quantidade;
+        if (anterior) bmais_no(a, anterior)->proxima = i;
+        anterior = i;
+        nivel[j] = i;
+        primeiro[j] = inicio;
+        inicio += quantidade;
+    }
+    a->altura = 1;
+
+    // Cada nivel acima reparte os nos do anterior; o vetor e reescrito no lugar
+    size_t k = folhas;
+    while (k > 1) {
+        size_t grupos = (k + a->capacidade) / (a->capacidade + 1);
+        size_t lido = 0;
+        for (size_t g = 0; g < grupos; g++) {
+            size_t quantidade = k / grupos + (g < k % grupos);
+            uint32_t i = bmais_novo_no(a, false);
+            NoBMais* no = bmais_no(a, i);
+            for (size_t f = 0; f < quantidade; f++) {
+                bmais_filhos(a, no)[f] = nivel[lido + f];
+                if (f > 0) bmais_gravar_par(a, no, (int)f - 1, pares[primeiro[lido + f]].chave, pares[primeiro[lido + f]].valor);
+            }
+            no->quantidade = (uint16_t)(quantidade - 1);
+            nivel[g] = i;
+            primeiro[g] = primeiro[lido];
+            lido += quantidade;
+        }
+        k = grupos;
+        a->altura++;
+    }
+
+    a->raiz = nivel[0];
+    a->tamanho = n;
+    free(nivel);
+    free(primeiro);
+}
+
+#endif
@@ -0,0 +1,834 @@
+// Arvore radix adaptativa (ART, Leis et al. 2013) indexada por strings.
+// Cada no interno consome um byte da chave, mas so ocupa o espaco dos filhos
+// que tem: No4 e No16 guardam os bytes ordenados ao lado dos filhos, No48
+// tem um indice de 256 bytes para 48 filhos e No256 e o vetor completo.
+// Os nos crescem e encolhem de tipo conforme ganham ou perdem filhos.
+//
+// Trechos sem bifurcacao sao comprimidos no proprio no (tamanho_prefixo):
+// os RADIX_MAX_PREFIXO primeiros bytes ficam guardados e, se o trecho for
+// maior, o resto e conferido na chave da folha (busca otimista).
+//
+// Nos e registros saem de arenas paginadas (uma por tipo de no e uma para os
+// registros), sem um malloc por item, e sao referenciados por indices de 32
+// bits em vez de ponteiros: um No16 cabe em 96 bytes em vez de 160. Itens
+// removidos voltam para a lista de livres da arena e radix_liberar devolve
+// tudo de uma vez. As paginas nao mudam de lugar, entao os ponteiros para
+// registros valem ate o registro ser removido.
+//
+// A arvore guarda uma copia de cada registro; a chave e uma string terminada
+// em '\0' dentro dele, informada pelo deslocamento no struct (como em
+// tabela_swiss.h). O '\0' entra na chave, entao nenhuma chave e prefixo de outra.
+//
+// Os percursos usam um cursor com pilha explicita (radix_primeiro e
+// radix_proximo), sem recursao; ao entrar num No4 ou No16 o cursor ja pede ao
+// processador os filhos seguintes. Chaves tem ate RADIX_MAX_CHAVE bytes, o
+// que limita a altura da pilha.
+#ifndef ARVORE_RADIX_H
+#define ARVORE_RADIX_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "cursor_arvore.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RADIX_SSE2 1
+#else
+#define RADIX_SSE2 0
+#endif
+
+#define RADIX_NO4 0
+#define RADIX_NO16 1
+#define RADIX_NO48 2
+#define RADIX_NO256 3
+#define RADIX_TIPOS 4
+#define RADIX_MAX_PREFIXO 8
+#define RADIX_BITS_PAGINA 8                        // Itens por pagina da arena: 256
+#define RADIX_ITENS_PAGINA (1u << RADIX_BITS_PAGINA)
+#define RADIX_MAX_NOS ((1u << 29) - 1)             // Indices de no usam 29 bits da referencia
+#define RADIX_MAX_REGISTROS (1u << 31)             // Indices de registro usam 31
+#define RADIX_MAX_CHAVE 64                         // Bytes da chave, contando o '\0'
+
+// Referencia de 32 bits: 0 = vazia; bit 0 ligado = folha (registro no bit 1
+// em diante); senao no interno, com o tipo nos bits 1-2 e indice + 1 acima
+typedef uint32_t RefRadix;
+
+// ================= ESTRUTURAS =================
+
+typedef struct ArenaRadix {
+    char** paginas;              // Paginas de RADIX_ITENS_PAGINA itens, nunca movidas
+    uint32_t num_paginas;
+    uint32_t capacidade_paginas;
+    uint32_t proximo;            // Itens ja entregues pelo ponteiro de avanco
+    uint32_t livre;              // Primeiro item livre + 1 (0 = lista vazia)
+    uint32_t vivos;
+    size_t tamanho_item;
+} ArenaRadix;
+
+typedef struct NoRadix {
+    uint16_t num_filhos;
+    uint32_t tamanho_prefixo;                 // Bytes comprimidos antes do byte de desvio
+    unsigned char prefixo[RADIX_MAX_PREFIXO]; // Ate RADIX_MAX_PREFIXO deles
+} NoRadix;
+
+typedef struct NoRadix4 {
+    NoRadix h;
+    unsigned char chaves[4]; // Ordenadas
+    RefRadix filhos[4];
+} NoRadix4;
+
+typedef struct NoRadix16 {
+    NoRadix h;
+    unsigned char chaves[16]; // Ordenadas
+    RefRadix filhos[16];
+} NoRadix16;
+
+typedef struct NoRadix48 {
+    NoRadix h;
+    unsigned char indice[256]; // Byte -> posicao em filhos + 1 (0 = sem filho)
+    RefRadix filhos[48];
+} NoRadix48;
+
+typedef struct NoRadix256 {
+    NoRadix h;
+    RefRadix filhos[256];
+} NoRadix256;
+
+typedef struct ArvoreRadix {
+    RefRadix raiz;
+    size_t deslocamento_chave;  // offsetof da chave dentro do registro
+    size_t quantidade;
+    ArenaRadix nos[RADIX_TIPOS];
+    ArenaRadix registros;
+} ArvoreRadix;
+
+// Cursor em ordem de chave: nos internos do caminho e o proximo filho de cada
+typedef struct CursorRadix {
+    const ArvoreRadix* a;
+    RefRadix nos[RADIX_MAX_CHAVE];
+    int posicoes[RADIX_MAX_CHAVE];
+    int topo;
+} CursorRadix;
+
+static const size_t RADIX_TAMANHO_NO[RADIX_TIPOS] = {
+    sizeof(NoRadix4), sizeof(NoRadix16), sizeof(NoRadix48), sizeof(NoRadix256)
+};
+
+// ================= ARENA =================
+
+static inline void radix_arena_iniciar(ArenaRadix* ar, size_t tamanho_item) {
+    memset(ar, 0, sizeof(*ar));
+    ar->tamanho_item = tamanho_item < sizeof(uint32_t) ? sizeof(uint32_t) : tamanho_item;
+}
+
+static inline void* radix_arena_item(const ArenaRadix* ar, uint32_t i) {
+    return ar->paginas[i >> RADIX_BITS_PAGINA] + (size_t)(i & (RADIX_ITENS_PAGINA - 1)) * ar->tamanho_item;
+}
+
+// Indice de um item zerado: reaproveita um livre ou avanca, abrindo pagina nova se preciso
+static inline uint32_t radix_arena_alocar(ArenaRadix* ar, uint32_t limite) {
+    uint32_t i;
+    if (ar->livre) {
+        i = ar->livre - 1;
+        ar->livre = *(uint32_t*)radix_arena_item(ar, i);
+    } else {
+        if (ar->proximo >= limite) {
+            fprintf(stderr, "Erro: limite de itens da arvore radix atingido.\n");
+            exit(1);
+        }
+        if ((ar->proximo >> RADIX_BITS_PAGINA) == ar->num_paginas) {
+            if (ar->num_paginas == ar->capacidade_paginas) {
+                uint32_t capacidade = ar->capacidade_paginas ? ar->capacidade_paginas * 2 : 16;
+                char** paginas = (char**)realloc(ar->paginas, capacidade * sizeof(char*));
+                if (!paginas) {
+                    fprintf(stderr, "Erro de alocacao de memoria.\n");
+                    exit(1);
+                }
+                ar->paginas = paginas;
+                ar->capacidade_paginas = capacidade;
+            }
+            ar->paginas[ar->num_paginas] = (char*)malloc(RADIX_ITENS_PAGINA * ar->tamanho_item);
+            if (!ar->paginas[ar->num_paginas]) {
+                fprintf(stderr, "Erro de alocacao de memoria.\n");
+                exit(1);
+            }
+            ar->num_paginas++;
+        }
+        i = ar->proximo++;
+    }
+    memset(radix_arena_item(ar, i), 0, ar->tamanho_item);
+    ar->vivos++;
+    return i;
+}
+
+static inline void radix_arena_devolver(ArenaRadix* ar, uint32_t i) {
+    *(uint32_t*)radix_arena_item(ar, i) = ar->livre;
+    ar->livre = i + 1;
+    ar->vivos--;
+}
+
+static inline void radix_arena_liberar(ArenaRadix* ar) {
+    for (uint32_t p = 0; p < ar->num_paginas; p++) free(ar->paginas[p]);
+    free(ar->paginas);
+    radix_arena_iniciar(ar, ar->tamanho_item);
+}
+
+static inline size_t radix_arena_memoria(const ArenaRadix* ar) {
+    return (size_t)ar->num_paginas * RADIX_ITENS_PAGINA * ar->tamanho_item + ar->capacidade_paginas * sizeof(char*);
+}
+
+// ================= FUNCOES AUXILIARES =================
+
+static inline bool radix_eh_folha(RefRadix r) {
+    return (r & 1) != 0;
+}
+
+static inline int radix_tipo(RefRadix r) {
+    return (int)((r >> 1) & 3);
+}
+
+static inline NoRadix* radix_no(const ArvoreRadix* a, RefRadix r) {
+    return (NoRadix*)radix_arena_item(&a->nos[radix_tipo(r)], (r >> 3) - 1);
+}
+
+static inline void* radix_registro(const ArvoreRadix* a, RefRadix r) {
+    return radix_arena_item(&a->registros, r >> 1);
+}
+
+static inline const unsigned char* radix_chave(const ArvoreRadix* a, const void* registro) {
+    return (const unsigned char*)registro + a->deslocamento_chave;
+}
+
+static inline const unsigned char* radix_chave_folha(const ArvoreRadix* a, RefRadix r) {
+    return radix_chave(a, radix_registro(a, r));
+}
+
+static inline size_t radix_min(size_t x, size_t y) {
+    return x < y ? x : y;
+}
+
+static inline RefRadix radix_alocar(ArvoreRadix* a, int tipo) {
+    uint32_t i = radix_arena_alocar(&a->nos[tipo], RADIX_MAX_NOS);
+    return ((i + 1) << 3) | ((RefRadix)tipo << 1);
+}
+
+static inline void radix_liberar_no(ArvoreRadix* a, RefRadix r) {
+    radix_arena_devolver(&a->nos[radix_tipo(r)], (r >> 3) - 1);
+}
+
+// Nova versao do no "r" com outro tipo: mesmo cabecalho, filhos copiados depois
+static inline RefRadix radix_trocar_tipo(ArvoreRadix* a, RefRadix r, int tipo) {
+    RefRadix novo = radix_alocar(a, tipo);
+    memcpy(radix_no(a, novo), radix_no(a, r), sizeof(NoRadix));
+    return novo;
+}
+
+// Posicao de "c" num vetor ordenado de bytes, ou -1
+static inline int radix_procurar_byte(const unsigned char* chaves, int n, unsigned char c) {
+#if RADIX_SSE2
+    if (n > 4) {
+        __m128i iguais = _mm_cmpeq_epi8(_mm_set1_epi8((char)c), _mm_loadu_si128((const __m128i*)chaves));
+        unsigned mascara = (unsigned)_mm_movemask_epi8(iguais) & ((1u << n) - 1);
+        if (!mascara) return -1;
+#if defined(_MSC_VER)
+        unsigned long indice;
+        _BitScanForward(&indice, mascara);
+        return (int)indice;
+#else
+        return __builtin_ctz(mascara);
+#endif
+    }
+#endif
+    for (int i = 0; i < n; i++)
+        if (chaves[i] == c) return i;
+    return -1;
+}
+
+// Endereco da referencia para o filho do byte "c", ou NULL
+static inline RefRadix* radix_filho(const ArvoreRadix* a, RefRadix r, unsigned char c) {
+    NoRadix* no = radix_no(a, r);
+    switch (radix_tipo(r)) {
+        case RADIX_NO4: {
+            NoRadix4* n = (NoRadix4*)no;
+            int i = radix_procurar_byte(n->chaves, no->num_filhos, c);
+            return i < 0 ? NULL : &n->filhos[i];
+        }
+        case RADIX_NO16: {
+            NoRadix16* n = (NoRadix16*)no;
+            int i = radix_procurar_byte(n->chaves, no->num_filhos, c);
+            return i < 0 ? NULL : &n->filhos[i];
+        }
+        case RADIX_NO48: {
+            NoRadix48* n = (NoRadix48*)no;
+            return n->indice[c] ? &n->filhos[n->indice[c] - 1] : NULL;
+        }
+        default: {
+            NoRadix256* n = (NoRadix256*)no;
+            return n->filhos[c] ? &n->filhos[c] : NULL;
+        }
+    }
+}
+
+// Folha de menor chave abaixo de "r"
+static inline RefRadix radix_minimo(const ArvoreRadix* a, RefRadix r) {
+    while (!radix_eh_folha(r)) {
+        const NoRadix* no = radix_no(a, r);
+        switch (radix_tipo(r)) {
+            case RADIX_NO4: r = ((const NoRadix4*)no)->filhos[0]; break;
+            case RADIX_NO16: r = ((const NoRadix16*)no)->filhos[0]; break;
+            case RADIX_NO48: {
+                const NoRadix48* n = (const NoRadix48*)no;
+                int c = 0;
+                while (!n->indice[c]) c++;
+                r = n->filhos[n->indice[c] - 1];
+                break;
+            }
+            default: {
+                const NoRadix256* n = (const NoRadix256*)no;
+                int c = 0;
+                while (!n->filhos[c]) c++;
+                r = n->filhos[c];
+                break;
+            }
+        }
+    }
+    return r;
+}
+
+// Bytes guardados do prefixo que batem com a chave a partir de "profundidade"
+static inline size_t radix_casar_prefixo(const NoRadix* no, const unsigned char* chave, size_t n, size_t profundidade) {
+    size_t limite = radix_min(radix_min(no->tamanho_prefixo, RADIX_MAX_PREFIXO), n - profundidade);
+    size_t i = 0;
+    while (i < limite && no->prefixo[i] == chave[profundidade + i]) i++;
+    return i;
+}
+
+// Como radix_casar_prefixo, mas confere o prefixo inteiro (o trecho nao
+// guardado vem da menor folha, que compartilha o prefixo do no)
+static inline size_t radix_divergencia(const ArvoreRadix* a, RefRadix r, const unsigned char* chave,
+                                       size_t n, size_t profundidade) {
+    const NoRadix* no = radix_no(a, r);
+    size_t i = radix_casar_prefixo(no, chave, n, profundidade);
+    if (i < RADIX_MAX_PREFIXO || no->tamanho_prefixo <= RADIX_MAX_PREFIXO) return i;
+    const unsigned char* folha = radix_chave_folha(a, radix_minimo(a, r));
+    size_t limite = radix_min(no->tamanho_prefixo, n - profundidade);
+    while (i < limite && folha[profundidade + i] == chave[profundidade + i]) i++;
+    return i;
+}
+
+// Insere o filho "c" em *ref, trocando o no por um maior se estiver cheio
+static inline void radix_adicionar_filho(ArvoreRadix* a, RefRadix* ref, unsigned char c, RefRadix filho) {
+    RefRadix r = *ref;
+    NoRadix* no = radix_no(a, r);
+    int tipo = radix_tipo(r);
+    switch (tipo) {
+        case RADIX_NO4:
+        case RADIX_NO16: {
+            int capacidade = tipo == RADIX_NO4 ? 4 : 16;
+            unsigned char* chaves = tipo == RADIX_NO4 ? ((NoRadix4*)no)->chaves : ((NoRadix16*)no)->chaves;
+            RefRadix* filhos = tipo == RADIX_NO4 ? ((NoRadix4*)no)->filhos : ((NoRadix16*)no)->filhos;
+            if (no->num_filhos < capacidade) {
+                int i = 0;
+                while (i < no->num_filhos && chaves[i] < c) i++;
+                memmove(chaves + i + 1, chaves + i, no->num_filhos - i);
+                memmove(filhos + i + 1, filhos + i, (no->num_filhos - i) * sizeof(RefRadix));
+                chaves[i] = c;
+                filhos[i] = filho;
+                no->num_filhos++;
+                return;
+            }
+            if (tipo == RADIX_NO4) {
+                RefRadix maior = radix_trocar_tipo(a, r, RADIX_NO16);
+                NoRadix16* n = (NoRadix16*)radix_no(a, maior);
+                memcpy(n->chaves, chaves, 4);
+                memcpy(n->filhos, filhos, 4 * sizeof(RefRadix));
+                *ref = maior;
+            } else {
+                RefRadix maior = radix_trocar_tipo(a, r, RADIX_NO48);
+                NoRadix48* n = (NoRadix48*)radix_no(a, maior);
+                for (int i = 0; i < 16; i++) {
+                    n->indice[chaves[i]] = (unsigned char)(i + 1);
+                    n->filhos[i] = filhos[i];
+                }
+                *ref = maior;
+            }
+            radix_liberar_no(a, r);
+            radix_adicionar_filho(a, ref, c, filho);
+            return;
+        }
+        case RADIX_NO48: {
+            NoRadix48* n = (NoRadix48*)no;
+            if (no->num_filhos < 48) {
+                int livre = 0;
+                while (n->filhos[livre]) livre++; // Remocoes deixam buracos
+                n->filhos[livre] = filho;
+                n->indice[c] = (unsigned char)(livre + 1);
+                no->num_filhos++;
+                return;
+            }
+            RefRadix maior = radix_trocar_tipo(a, r, RADIX_NO256);
+            NoRadix256* m = (NoRadix256*)radix_no(a, maior);
+            for (int b = 0; b < 256; b++)
+                if (n->indice[b]) m->filhos[b] = n->filhos[n->indice[b] - 1];
+            m->filhos[c] = filho;
+            m->h.num_filhos++;
+            *ref = maior;
+            radix_liberar_no(a, r);
+            return;
+        }
+        default:
+            ((NoRadix256*)no)->filhos[c] = filho;
+            no->num_filhos++;
+            return;
+    }
+}
+
+// Tira o filho "c" (no endereco "filho") de *ref, trocando por um no menor
+// quando sobra pouco; um No4 com um so filho e fundido com ele
+static inline void radix_remover_filho(ArvoreRadix* a, RefRadix* ref, unsigned char c, RefRadix* filho) {
+    RefRadix r = *ref;
+    NoRadix* no = radix_no(a, r);
+    int tipo = radix_tipo(r);
+    switch (tipo) {
+        case RADIX_NO4:
+        case RADIX_NO16: {
+            unsigned char* chaves = tipo == RADIX_NO4 ? ((NoRadix4*)no)->chaves : ((NoRadix16*)no)->chaves;
+            RefRadix* filhos = tipo == RADIX_NO4 ? ((NoRadix4*)no)->filhos : ((NoRadix16*)no)->filhos;
+            int i = (int)(filho - filhos);
+            memmove(chaves + i, chaves + i + 1, no->num_filhos - i - 1);
+            memmove(filhos + i, filhos + i + 1, (no->num_filhos - i - 1) * sizeof(RefRadix));
+            no->num_filhos--;
+
+            if (tipo == RADIX_NO16 && no->num_filhos == 3) {
+                RefRadix menor = radix_trocar_tipo(a, r, RADIX_NO4);
+                NoRadix4* n = (NoRadix4*)radix_no(a, menor);
+                memcpy(n->chaves, chaves, 3);
+                memcpy(n->filhos, filhos, 3 * sizeof(RefRadix));
+                *ref = menor;
+                radix_liberar_no(a, r);
+            } else if (tipo == RADIX_NO4 && no->num_filhos == 1) {
+                RefRadix unico = filhos[0];
+                if (!radix_eh_folha(unico)) {
+                    // Prefixo do filho passa a ser: prefixo do no + byte de desvio + prefixo do filho
+                    NoRadix* neto = radix_no(a, unico);
+                    unsigned char juntos[RADIX_MAX_PREFIXO];
+                    size_t k = radix_min(no->tamanho_prefixo, RADIX_MAX_PREFIXO);
+                    memcpy(juntos, no->prefixo, k);
+                    if (k < RADIX_MAX_PREFIXO) juntos[k++] = chaves[0];
+                    for (size_t j = 0; k < RADIX_MAX_PREFIXO && j < neto->tamanho_prefixo; j++)
+                        juntos[k++] = neto->prefixo[j];
+                    neto->tamanho_prefixo += no->tamanho_prefixo + 1;
+                    memcpy(neto->prefixo, juntos, radix_min(neto->tamanho_prefixo, RADIX_MAX_PREFIXO));
+                }
+                *ref = unico;
+                radix_liberar_no(a, r);
+            }
+            return;
+        }
+        case RADIX_NO48: {
+            NoRadix48* n = (NoRadix48*)no;
+            n->filhos[n->indice[c] - 1] = 0;
+            n->indice[c] = 0;
+            no->num_filhos--;
+            if (no->num_filhos == 12) {
+                RefRadix menor = radix_trocar_tipo(a, r, RADIX_NO16);
+                NoRadix16* m = (NoRadix16*)radix_no(a, menor);
+                int k = 0;
+                for (int b = 0; b < 256; b++)
+                    if (n->indice[b]) {
+                        m->chaves[k] = (unsigned char)b;
+                        m->filhos[k++] = n->filhos[n->indice[b] - 1];
+                    }
+                *ref = menor;
+                radix_liberar_no(a, r);
+            }
+            return;
+        }
+        default: {
+            NoRadix256* n = (NoRadix256*)no;
+            n->filhos[c] = 0;
+            no->num_filhos--;
+            if (no->num_filhos == 37) {
+                RefRadix menor = radix_trocar_tipo(a, r, RADIX_NO48);
+                NoRadix48* m = (NoRadix48*)radix_no(a, menor);
+                int k = 0;
+                for (int b = 0; b < 256; b++)
+                    if (n->filhos[b]) {
+                        m->indice[b] = (unsigned char)(k + 1);
+                        m->filhos[k++] = n->filhos[b];
+                    }
+                *ref = menor;
+                radix_liberar_no(a, r);
+            }
+            return;
+        }
+    }
+}
+
+// Insere a folha "nova" (registro ja copiado para a arena). Se a chave ja
+// existia, devolve a folha antiga, que sai da arvore
+static inline RefRadix radix_inserir_em(ArvoreRadix* a, RefRadix* ref, RefRadix nova, const unsigned char* chave,
+                                        size_t n, size_t profundidade) {
+    RefRadix r = *ref;
+    if (!r) {
+        *ref = nova;
+        return 0;
+    }
+
+    if (radix_eh_folha(r)) {
+        const unsigned char* outra = radix_chave_folha(a, r);
+        if (strcmp((const char*)outra, (const char*)chave) == 0) {
+            *ref = nova;
+            return r;
+        }
+        // Duas folhas: No4 com o trecho comum como prefixo
+        size_t comum = 0;
+        while (outra[profundidade + comum] == chave[profundidade + comum]) comum++;
+        RefRadix novo = radix_alocar(a, RADIX_NO4);
+        NoRadix* no = radix_no(a, novo);
+        no->tamanho_prefixo = (uint32_t)comum;
+        memcpy(no->prefixo, chave + profundidade, radix_min(comum, RADIX_MAX_PREFIXO));
+        *ref = novo;
+        radix_adicionar_filho(a, ref, outra[profundidade + comum], r);
+        radix_adicionar_filho(a, ref, chave[profundidade + comum], nova);
+        return 0;
+    }
+
+    NoRadix* no = radix_no(a, r);
+    if (no->tamanho_prefixo) {
+        size_t divergencia = radix_divergencia(a, r, chave, n, profundidade);
+        if (divergencia < no->tamanho_prefixo) {
+            // A chave sai no meio do prefixo: novo No4 acima, com o trecho comum
+            RefRadix acima = radix_alocar(a, RADIX_NO4);
+            NoRadix* topo = radix_no(a, acima);
+            topo->tamanho_prefixo = (uint32_t)divergencia;
+            memcpy(topo->prefixo, no->prefixo, radix_min(divergencia, RADIX_MAX_PREFIXO));
+            *ref = acima;
+
+            unsigned char desvio;
+            if (no->tamanho_prefixo <= RADIX_MAX_PREFIXO) {
+                desvio = no->prefixo[divergencia];
+                no->tamanho_prefixo -= (uint32_t)divergencia + 1;
+                memmove(no->prefixo, no->prefixo + divergencia + 1, radix_min(no->tamanho_prefixo, RADIX_MAX_PREFIXO));
+            } else {
+                const unsigned char* folha = radix_chave_folha(a, radix_minimo(a, r));
+                desvio = folha[profundidade + divergencia];
+                no->tamanho_prefixo -= (uint32_t)divergencia + 1;
+                memcpy(no->prefixo, folha + profundidade + divergencia + 1,
+                       radix_min(no->tamanho_prefixo, RADIX_MAX_PREFIXO));
+            }
+            radix_adicionar_filho(a, ref, desvio, r);
+            radix_adicionar_filho(a, ref, chave[profundidade + divergencia], nova);
+            return 0;
+        }
+        profundidade += no->tamanho_prefixo;
+    }
+
+    RefRadix* filho = radix_filho(a, r, chave[profundidade]);
+    if (filho) return radix_inserir_em(a, filho, nova, chave, n, profundidade + 1);
+    radix_adicionar_filho(a, ref, chave[profundidade], nova);
+    return 0;
+}
+
+// Tira a chave da arvore e devolve a folha dela (0 se nao estava)
+static inline RefRadix radix_remover_em(ArvoreRadix* a, RefRadix* ref, const unsigned char* chave, size_t n,
+                                        size_t profundidade) {
+    RefRadix r = *ref;
+    if (!r) return 0;
+    if (radix_eh_folha(r)) { // So acontece com a folha na raiz
+        if (strcmp((const char*)radix_chave_folha(a, r), (const char*)chave) != 0) return 0;
+        *ref = 0;
+        return r;
+    }
+
+    const NoRadix* no = radix_no(a, r);
+    if (no->tamanho_prefixo) {
+        if (radix_casar_prefixo(no, chave, n, profundidade) != radix_min(no->tamanho_prefixo, RADIX_MAX_PREFIXO))
+            return 0;
+        profundidade += no->tamanho_prefixo;
+    }
+    if (profundidade >= n) return 0;
+
+    unsigned char c = chave[profundidade];
+    RefRadix* filho = radix_filho(a, r, c);
+    if (!filho) return 0;
+    if (!radix_eh_folha(*filho)) return radix_remover_em(a, filho, chave, n, profundidade + 1);
+
+    RefRadix folha = *filho;
+    if (strcmp((const char*)radix_chave_folha(a, folha), (const char*)chave) != 0) return 0;
+    radix_remover_filho(a, ref, c, filho);
+    return folha;
+}
+
+typedef void (*VisitaRadix)(void* registro, void* contexto);
+
+// Proximo filho de "r" em ordem de byte a partir de *posicao (comece em 0);
+// devolve 0 no fim. *byte recebe o byte de desvio do filho
+static inline RefRadix radix_proximo_filho(const ArvoreRadix* a, RefRadix r, int* posicao, unsigned char* byte) {
+    const NoRadix* no = radix_no(a, r);
+    switch (radix_tipo(r)) {
+        case RADIX_NO4:
+        case RADIX_NO16: {
+            if (*posicao >= no->num_filhos) return 0;
+            int i = (*posicao)++;
+            if (radix_tipo(r) == RADIX_NO4) {
+                *byte = ((const NoRadix4*)no)->chaves[i];
+                return ((const NoRadix4*)no)->filhos[i];
+            }
+            *byte = ((const NoRadix16*)no)->chaves[i];
+            return ((const NoRadix16*)no)->filhos[i];
+        }
+        case RADIX_NO48: {
+            const NoRadix48* n = (const NoRadix48*)no;
+            while (*posicao < 256 && !n->indice[*posicao]) (*posicao)++;
+            if (*posicao >= 256) return 0;
+            *byte = (unsigned char)*posicao;
+            return n->filhos[n->indice[(*posicao)++] - 1];
+        }
+        default: {
+            const NoRadix256* n = (const NoRadix256*)no;
+            while (*posicao < 256 && !n->filhos[*posicao]) (*posicao)++;
+            if (*posicao >= 256) return 0;
+            *byte = (unsigned char)*posicao;
+            return n->filhos[(*posicao)++];
+        }
+    }
+}
+
+// Pede ao processador os filhos de um No4/No16 (nos ou registros), que o
+// cursor vai visitar em seguida
+static inline void radix_prefetch_filhos(const ArvoreRadix* a, RefRadix r) {
+    int tipo = radix_tipo(r);
+    if (tipo != RADIX_NO4 && tipo != RADIX_NO16) return;
+    const NoRadix* no = radix_no(a, r);
+    const RefRadix* filhos = tipo == RADIX_NO4 ? ((const NoRadix4*)no)->filhos : ((const NoRadix16*)no)->filhos;
+    for (int i = 0; i < no->num_filhos; i++)
+        CURSOR_PREFETCH(radix_eh_folha(filhos[i]) ? radix_registro(a, filhos[i]) : (void*)radix_no(a, filhos[i]));
+}
+
+static inline void radix_cursor_empilhar(CursorRadix* c, RefRadix r) {
+    c->nos[c->topo] = r;
+    c->posicoes[c->topo++] = 0;
+    radix_prefetch_filhos(c->a, r);
+}
+
+// Proximo registro em ordem, ou NULL no fim
+static inline void* radix_proximo(CursorRadix* c) {
+    while (c->topo > 0) {
+        int t = c->topo - 1;
+        unsigned char byte;
+        RefRadix filho = radix_proximo_filho(c->a, c->nos[t], &c->posicoes[t], &byte);
+        if (!filho)
+            c->topo--;
+        else if (radix_eh_folha(filho))
+            return radix_registro(c->a, filho);
+        else
+            radix_cursor_empilhar(c, filho);
+    }
+    return NULL;
+}
+
+// Posiciona o cursor no primeiro registro da subarvore "r" e o devolve
+static inline void* radix_cursor_iniciar(CursorRadix* c, const ArvoreRadix* a, RefRadix r) {
+    c->a = a;
+    c->topo = 0;
+    if (!r) return NULL;
+    if (radix_eh_folha(r)) return radix_registro(a, r); // Subarvore de uma folha so
+    radix_cursor_empilhar(c, r);
+    return radix_proximo(c);
+}
+
+static inline void radix_para_cada_em(const ArvoreRadix* a, RefRadix r, VisitaRadix visita, void* contexto) {
+    CursorRadix c;
+    for (void* registro = radix_cursor_iniciar(&c, a, r); registro; registro = radix_proximo(&c))
+        visita(registro, contexto);
+}
+
+// Subarvore com as chaves que comecam com "prefixo" (0 se nao houver): desce
+// so pelo caminho do prefixo
+static inline RefRadix radix_subarvore_prefixo(const ArvoreRadix* a, const char* prefixo) {
+    const unsigned char* p = (const unsigned char*)prefixo;
+    size_t m = strlen(prefixo), profundidade = 0;
+    RefRadix r = a->raiz;
+    while (r && !radix_eh_folha(r) && profundidade < m) {
+        const NoRadix* no = radix_no(a, r);
+        if (no->tamanho_prefixo) {
+            if (radix_casar_prefixo(no, p, m, profundidade) !=
+                radix_min(radix_min(no->tamanho_prefixo, RADIX_MAX_PREFIXO), m - profundidade))
+                return 0;
+            profundidade += no->tamanho_prefixo;
+            if (profundidade >= m) break;
+        }
+        RefRadix* filho = radix_filho(a, r, p[profundidade++]);
+        r = filho ? *filho : 0;
+    }
+    if (!r) return 0;
+    // Toda a subarvore tem os mesmos primeiros bytes: basta conferir uma folha
+    // (cobre os bytes de prefixo nao guardados, pulados acima)
+    if (strncmp((const char*)radix_chave_folha(a, radix_minimo(a, r)), prefixo, m) != 0) return 0;
+    return r;
+}
+
+// Compara "n" bytes do trecho de chave do no com o limite (a partir do mesmo
+// ponto); o limite pode acabar antes, no '\0', que e menor que qualquer byte
+static inline int radix_comparar_trecho(const unsigned char* trecho, const unsigned char* limite, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (trecho[i] != limite[i]) return trecho[i] < limite[i] ? -1 : 1;
+        if (!limite[i]) return 0;
+    }
+    return 0;
+}
+
+// Visita as chaves de "r" entre inicio e fim (inclusive). "preso_inicio"
+// indica que o caminho ate aqui e igual ao comeco de "inicio", entao o limite
+// ainda restringe esta subarvore; o mesmo para "preso_fim". Subarvores soltas
+// dos dois lados sao visitadas inteiras, e as de fora nem sao abertas
+static inline void radix_intervalo_em(const ArvoreRadix* a, RefRadix r, size_t profundidade,
+                                      const unsigned char* inicio, bool preso_inicio,
+                                      const unsigned char* fim, bool preso_fim, VisitaRadix visita, void* contexto) {
+    if (!preso_inicio && !preso_fim) {
+        radix_para_cada_em(a, r, visita, contexto);
+        return;
+    }
+    if (radix_eh_folha(r)) {
+        const char* chave = (const char*)radix_chave_folha(a, r);
+        if ((!preso_inicio || strcmp(chave, (const char*)inicio) >= 0) &&
+            (!preso_fim || strcmp(chave, (const char*)fim) <= 0))
+            visita(radix_registro(a, r), contexto);
+        return;
+    }
+
+    const NoRadix* no = radix_no(a, r);
+    if (no->tamanho_prefixo) {
+        // Trecho inteiro do prefixo: guardado no no ou, se maior, na menor folha
+        const unsigned char* trecho = no->tamanho_prefixo <= RADIX_MAX_PREFIXO
+                                          ? no->prefixo
+                                          : radix_chave_folha(a, radix_minimo(a, r)) + profundidade;
+        if (preso_inicio) {
+            int cmp = radix_comparar_trecho(trecho, inicio + profundidade, no->tamanho_prefixo);
+            if (cmp < 0) return;
+            preso_inicio = cmp == 0;
+        }
+        if (preso_fim) {
+            int cmp = radix_comparar_trecho(trecho, fim + profundidade, no->tamanho_prefixo);
+            if (cmp > 0) return;
+            preso_fim = cmp == 0;
+        }
+        profundidade += no->tamanho_prefixo;
+    }
+
+    int posicao = 0;
+    unsigned char byte;
+    for (RefRadix filho; (filho = radix_proximo_filho(a, r, &posicao, &byte)) != 0;) {
+        if (preso_inicio && byte < inicio[profundidade]) continue;
+        if (preso_fim && byte > fim[profundidade]) break;
+        radix_intervalo_em(a, filho, profundidade + 1, inicio, preso_inicio && byte == inicio[profundidade],
+                           fim, preso_fim && byte == fim[profundidade], visita, contexto);
+    }
+}
+
+// ================= OPERACOES =================
+
+static inline void radix_iniciar(ArvoreRadix* a, size_t tamanho_registro, size_t deslocamento_chave) {
+    memset(a, 0, sizeof(*a));
+    a->deslocamento_chave = deslocamento_chave;
+    for (int t = 0; t < RADIX_TIPOS; t++) radix_arena_iniciar(&a->nos[t], RADIX_TAMANHO_NO[t]);
+    radix_arena_iniciar(&a->registros, tamanho_registro);
+}
+
+// Libera nos e registros de uma vez, pagina por pagina
+static inline void radix_liberar(ArvoreRadix* a) {
+    for (int t = 0; t < RADIX_TIPOS; t++) radix_arena_liberar(&a->nos[t]);
+    radix_arena_liberar(&a->registros);
+    a->raiz = 0;
+    a->quantidade = 0;
+}
+
+static inline void* radix_buscar(const ArvoreRadix* a, const char* texto) {
+    const unsigned char* chave = (const unsigned char*)texto;
+    size_t n = strlen(texto) + 1, profundidade = 0;
+    RefRadix r = a->raiz;
+    while (r) {
+        if (radix_eh_folha(r)) {
+            void* registro = radix_registro(a, r);
+            return strcmp((const char*)radix_chave(a, registro), texto) == 0 ? registro : NULL;
+        }
+        const NoRadix* no = radix_no(a, r);
+        if (no->tamanho_prefixo) {
+            if (radix_casar_prefixo(no, chave, n, profundidade) != radix_min(no->tamanho_prefixo, RADIX_MAX_PREFIXO))
+                return NULL;
+            profundidade += no->tamanho_prefixo; // Bytes nao guardados sao conferidos na folha
+        }
+        if (profundidade >= n) return NULL;
+        RefRadix* filho = radix_filho(a, r, chave[profundidade++]);
+        r = filho ? *filho : 0;
+    }
+    return NULL;
+}
+
+// Copia o registro para a arena e o indexa (ou substitui, se a chave ja
+// existir); devolve o registro guardado, ou NULL se a chave for longa demais
+static inline void* radix_inserir(ArvoreRadix* a, const void* registro) {
+    if (strlen((const char*)radix_chave(a, registro)) >= RADIX_MAX_CHAVE) return NULL;
+    uint32_t i = radix_arena_alocar(&a->registros, RADIX_MAX_REGISTROS);
+    void* destino = radix_arena_item(&a->registros, i);
+    memcpy(destino, registro, a->registros.tamanho_item);
+    RefRadix nova = (i << 1) | 1;
+
+    const unsigned char* chave = radix_chave(a, destino);
+    RefRadix antiga = radix_inserir_em(a, &a->raiz, nova, chave, strlen((const char*)chave) + 1, 0);
+    if (antiga)
+        radix_arena_devolver(&a->registros, antiga >> 1);
+    else
+        a->quantidade++;
+    return destino;
+}
+
+// Tira a chave da arvore e devolve o registro dela para a arena
+static inline bool radix_remover(ArvoreRadix* a, const char* texto) {
+    RefRadix folha = radix_remover_em(a, &a->raiz, (const unsigned char*)texto, strlen(texto) + 1, 0);
+    if (!folha) return false;
+    radix_arena_devolver(&a->registros, folha >> 1);
+    a->quantidade--;
+    return true;
+}
+
+// Visita os registros em ordem crescente de chave
+static inline void radix_para_cada(const ArvoreRadix* a, VisitaRadix visita, void* contexto) {
+    radix_para_cada_em(a, a->raiz, visita, contexto);
+}
+
+// Cursor sobre todos os registros, em ordem de chave
+static inline void* radix_primeiro(CursorRadix* c, const ArvoreRadix* a) {
+    return radix_cursor_iniciar(c, a, a->raiz);
+}
+
+// Cursor sobre os registros cujas chaves comecam com "prefixo"
+static inline void* radix_primeiro_prefixo(CursorRadix* c, const ArvoreRadix* a, const char* prefixo) {
+    return radix_cursor_iniciar(c, a, radix_subarvore_prefixo(a, prefixo));
+}
+
+// Visita, em ordem, as chaves que comecam com "prefixo"
+static inline void radix_para_cada_prefixo(const ArvoreRadix* a, const char* prefixo, VisitaRadix visita, void* contexto) {
+    radix_para_cada_em(a, radix_subarvore_prefixo(a, prefixo), visita, contexto);
+}
+
+// Visita, em ordem, as chaves "k" com inicio <= k <= fim (ordem de strcmp)
+static inline void radix_para_cada_intervalo(const ArvoreRadix* a, const char* inicio, const char* fim,
+                                             VisitaRadix visita, void* contexto) {
+    if (!a->raiz || strcmp(inicio, fim) > 0) return;
+    radix_intervalo_em(a, a->raiz, 0, (const unsigned char*)inicio, true, (const unsigned char*)fim, true,
+                       visita, contexto);
+}
+
+// Bytes reservados para os nos internos (os registros nao entram)
+static inline size_t radix_memoria(const ArvoreRadix* a) {
+    size_t total = sizeof(*a);
+    for (int t = 0; t < RADIX_TIPOS; t++) total += radix_arena_memoria(&a->nos[t]);
+    return total;
+}
+
+#endif
@@ -0,0 +1,273 @@
+// AVL de estatistica de ordem sobre os valores (amount) das transacoes.
+// Cada no guarda um valor distinto com quantas transacoes o tem, e agrega a
+// sua subarvore: quantidade, soma, soma dos quadrados, fraudes e a moda.
+// Assim contagem, soma, media, desvio, mediana, qualquer percentil, posto
+// de um valor e moda saem em O(log n) (ou O(1), na raiz), sem percorrer
+// nem ordenar as transacoes.
+//
+// Os agregados sao refeitos por valores_atualizar, chamada de baixo para
+// cima na insercao, na remocao e nas rotacoes.
+//
+// Cada no tem ainda o primeiro de uma lista de registros com o seu valor,
+// para quem quiser chegar das faixas de valores as transacoes. A lista (o
+// encadeamento entre os registros) e mantida por quem usa a arvore; os nos
+// nunca trocam de conteudo, entao a cabeca acompanha o valor nas rotacoes.
+#ifndef ARVORE_VALORES_H
+#define ARVORE_VALORES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct NoValor {
+    float valor;
+    int repeticoes;              // Transacoes com este valor
+    int fraudes;                 // Das quais sao fraude
+    uint32_t registros;          // Primeiro registro com este valor (0 = nenhum)
+    struct NoValor* esquerda;
+    struct NoValor* direita;
+    uint8_t altura;
+    // Agregados da subarvore (inclui o proprio no)
+    int tamanho;
+    int total_fraudes;
+    double soma;
+    double soma_quadrados;
+    float moda;                  // Valor mais repetido; no empate, o menor
+    int moda_repeticoes;
+} NoValor;
+
+static inline int valores_altura(const NoValor* no) { return no ? no->altura : 0; }
+static inline int valores_tamanho(const NoValor* no) { return no ? no->tamanho : 0; }
+static inline int valores_fraudes(const NoValor* no) { return no ? no->total_fraudes : 0; }
+static inline double valores_soma(const NoValor* no) { return no ? no->soma : 0; }
+static inline double valores_soma_quadrados(const NoValor* no) { return no ? no->soma_quadrados : 0; }
+
+static inline void valores_atualizar(NoValor* no) {
+    NoValor* e = no->esquerda;
+    NoValor* d = no->direita;
+    int ae = valores_altura(e), ad = valores_altura(d);
+    no->altura = (uint8_t)((ae > ad ? ae : ad) + 1);
+    no->tamanho = valores_tamanho(e) + no->repeticoes + valores_tamanho(d);
+    no->total_fraudes = valores_fraudes(e) + no->fraudes + valores_fraudes(d);
+    double parcela = (double)no->valor * no->repeticoes;
+    no->soma = valores_soma(e) + parcela + valores_soma(d);
+    no->soma_quadrados = valores_soma_quadrados(e) + parcela * no->valor + valores_soma_quadrados(d);
+    // Esquerda, no e direita estao em ordem crescente: so troca com mais repeticoes
+    no->moda = no->valor;
+    no->moda_repeticoes = no->repeticoes;
+    if (e && e->moda_repeticoes >= no->moda_repeticoes) {
+        no->moda = e->moda;
+        no->moda_repeticoes = e->moda_repeticoes;
+    }
+    if (d && d->moda_repeticoes > no->moda_repeticoes) {
+        no->moda = d->moda;
+        no->moda_repeticoes = d->moda_repeticoes;
+    }
+}
+
+static inline NoValor* valores_rotacao_direita(NoValor* y) {
+    NoValor* x = y->esquerda;
+    y->esquerda = x->direita;
+    x->direita = y;
+    valores_atualizar(y);
+    valores_atualizar(x);
+    return x;
+}
+
+static inline NoValor* valores_rotacao_esquerda(NoValor* x) {
+    NoValor* y = x->direita;
+    x->direita = y->esquerda;
+    y->esquerda = x;
+    valores_atualizar(x);
+    valores_atualizar(y);
+    return y;
+}
+
+// Refaz os agregados de "no" e corrige o balanceamento, se preciso
+static inline NoValor* valores_balancear(NoValor* no) {
+    valores_atualizar(no);
+    int fator = valores_altura(no->esquerda) - valores_altura(no->direita);
+    if (fator > 1) {
+        if (valores_altura(no->esquerda->esquerda) < valores_altura(no->esquerda->direita))
+            no->esquerda = valores_rotacao_esquerda(no->esquerda);
+        return valores_rotacao_direita(no);
+    }
+    if (fator < -1) {
+        if (valores_altura(no->direita->direita) < valores_altura(no->direita->esquerda))
+            no->direita = valores_rotacao_direita(no->direita);
+        return valores_rotacao_esquerda(no);
+    }
+    return no;
+}
+
+// Conta mais uma transacao com "valor"; devolve a nova raiz
+static inline NoValor* valores_inserir(NoValor* no, float valor, bool fraude) {
+    if (!no) {
+        no = (NoValor*)malloc(sizeof(NoValor));
+        if (!no) {
+            fprintf(stderr, "Erro de alocacao de memoria.\n");
+            exit(1);
+        }
+        no->valor = valor;
+        no->repeticoes = 1;
+        no->fraudes = fraude ? 1 : 0;
+        no->registros = 0;
+        no->esquerda = no->direita = NULL;
+        valores_atualizar(no);
+        return no;
+    }
+    if (valor < no->valor)
+        no->esquerda = valores_inserir(no->esquerda, valor, fraude);
+    else if (valor > no->valor)
+        no->direita = valores_inserir(no->direita, valor, fraude);
+    else {
+        no->repeticoes++;
+        if (fraude) no->fraudes++;
+    }
+    return valores_balancear(no);
+}
+
+// Desliga o menor no da subarvore, devolvendo-o em *minimo
+static inline NoValor* valores_desligar_minimo(NoValor* no, NoValor** minimo) {
+    if (!no->esquerda) {
+        *minimo = no;
+        return no->direita;
+    }
+    no->esquerda = valores_desligar_minimo(no->esquerda, minimo);
+    return valores_balancear(no);
+}
+
+// Desconta uma transacao com "valor" (o no sai quando nao sobra nenhuma);
+// devolve a nova raiz
+static inline NoValor* valores_remover(NoValor* no, float valor, bool fraude) {
+    if (!no) return NULL;
+    if (valor < no->valor)
+        no->esquerda = valores_remover(no->esquerda, valor, fraude);
+    else if (valor > no->valor)
+        no->direita = valores_remover(no->direita, valor, fraude);
+    else {
+        no->repeticoes--;
+        if (fraude && no->fraudes > 0) no->fraudes--;
+        if (no->repeticoes == 0) {
+            NoValor* esquerda = no->esquerda;
+            NoValor* direita = no->direita;
+            free(no);
+            if (!direita) return esquerda;
+            NoValor* sucessor;
+            direita = valores_desligar_minimo(direita, &sucessor);
+            sucessor->esquerda = esquerda;
+            sucessor->direita = direita;
+            no = sucessor;
+        }
+    }
+    return valores_balancear(no);
+}
+
+// Arvore balanceada em O(n) a partir de nos[inicio, fim), ja em ordem
+// crescente de valor e com valor, repeticoes, fraudes e registros preenchidos
+static inline NoValor* valores_montar(NoValor** nos, size_t inicio, size_t fim) {
+    if (inicio >= fim) return NULL;
+    size_t meio = inicio + (fim - inicio) / 2;
+    NoValor* no = nos[meio];
+    no->esquerda = valores_montar(nos, inicio, meio);
+    no->direita = valores_montar(nos, meio + 1, fim);
+    valores_atualizar(no);
+    return no;
+}
+
+static inline NoValor* valores_buscar(NoValor* no, float valor) {
+    while (no && valor != no->valor)
+        no = valor < no->valor ? no->esquerda : no->direita;
+    return no;
+}
+
+// Chama "visitar" para cada no com valor em [minimo, maximo], em ordem
+// crescente, sem descer nas subarvores fora da faixa
+static inline void valores_visitar_faixa(NoValor* no, float minimo, float maximo,
+                                         void (*visitar)(NoValor* no, void* contexto), void* contexto) {
+    while (no) {
+        if (no->valor < minimo) {
+            no = no->direita;
+        } else if (no->valor > maximo) {
+            no = no->esquerda;
+        } else {
+            valores_visitar_faixa(no->esquerda, minimo, maximo, visitar, contexto);
+            visitar(no, contexto);
+            no = no->direita;
+        }
+    }
+}
+
+static inline void valores_liberar(NoValor* no) {
+    while (no) {
+        valores_liberar(no->esquerda);
+        NoValor* direita = no->direita;
+        free(no);
+        no = direita;
+    }
+}
+
+// k-esimo menor valor, contando as repeticoes (0 <= k < tamanho)
+static inline float valores_k_esimo(const NoValor* no, int k) {
+    while (no) {
+        int esquerda = valores_tamanho(no->esquerda);
+        if (k < esquerda)
+            no = no->esquerda;
+        else if (k < esquerda + no->repeticoes)
+            return no->valor;
+        else {
+            k -= esquerda + no->repeticoes;
+            no = no->direita;
+        }
+    }
+    return 0;
+}
+
+// Mediana: o valor central, ou a media dos dois centrais se a quantidade e par
+static inline float valores_mediana(const NoValor* raiz) {
+    int n = valores_tamanho(raiz);
+    if (n == 0) return 0;
+    if (n % 2) return valores_k_esimo(raiz, n / 2);
+    return (valores_k_esimo(raiz, n / 2 - 1) + valores_k_esimo(raiz, n / 2)) / 2;
+}
+
+// Percentil p (0 a 100) com interpolacao linear entre os vizinhos
+static inline float valores_percentil(const NoValor* raiz, double p) {
+    int n = valores_tamanho(raiz);
+    if (n == 0) return 0;
+    if (p < 0) p = 0;
+    if (p > 100) p = 100;
+    double posicao = p / 100.0 * (n - 1);
+    int k = (int)posicao;
+    float abaixo = valores_k_esimo(raiz, k);
+    if (k + 1 >= n || posicao == k) return abaixo;
+    float acima = valores_k_esimo(raiz, k + 1);
+    return (float)(abaixo + (acima - abaixo) * (posicao - k));
+}
+
+// Posto de "valor": quantas transacoes tem valor estritamente menor
+static inline int valores_posto(const NoValor* no, float valor) {
+    int menores = 0;
+    while (no) {
+        if (valor <= no->valor)
+            no = no->esquerda;
+        else {
+            menores += valores_tamanho(no->esquerda) + no->repeticoes;
+            no = no->direita;
+        }
+    }
+    return menores;
+}
+
+static inline float valores_minimo(const NoValor* no) {
+    while (no->esquerda) no = no->esquerda;
+    return no->valor;
+}
+
+static inline float valores_maximo(const NoValor* no) {
+    while (no->direita) no = no->direita;
+    return no->valor;
+}
+
+#endif
@@ -0,0 +1,92 @@
+// Codificacao de transaction_id em chave inteira de 64 bits.
+// IDs regulares do dataset ("T" ou "TRN" seguido de 1 a 17 digitos) viram
+// um inteiro que pode ser comparado e hasheado direto, sem strcmp:
+//   bit 63     0 (regular)
+//   bit 62     prefixo: 0 = "T", 1 = "TRN"
+//   bits 57-61 quantidade de digitos (zeros a esquerda contam: T007 != T7)
+//   bits 0-56  valor numerico (10^17 - 1 < 2^57)
+// Qualquer outro formato e irregular: bit 63 ligado e os demais bits com um
+// hash do texto. Chaves irregulares iguais ainda precisam de strcmp para
+// confirmar, o que codec_id_iguais/codec_id_comparar ja fazem.
+//
+// A ordem das chaves regulares e numerica dentro de cada prefixo e
+// quantidade de digitos; entre IDs de mesmo tamanho coincide com strcmp.
+#ifndef CODEC_ID_H
+#define CODEC_ID_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include "hash_rapido.h"
+
+#define CODEC_IRREGULAR (1ull << 63)
+#define CODEC_PREFIXO_TRN (1ull << 62)
+#define CODEC_DESLOC_DIGITOS 57
+#define CODEC_MAX_DIGITOS 17
+#define CODEC_MASCARA_VALOR ((1ull << CODEC_DESLOC_DIGITOS) - 1)
+
+static inline uint64_t codec_id_codificar(const char* id) {
+    const char* p = id;
+    uint64_t prefixo;
+    if (p[0] == 'T' && p[1] == 'R' && p[2] == 'N') {
+        prefixo = CODEC_PREFIXO_TRN;
+        p += 3;
+    } else if (p[0] == 'T') {
+        prefixo = 0;
+        p += 1;
+    } else {
+        return CODEC_IRREGULAR | (hash_texto(id) >> 1);
+    }
+
+    uint64_t valor = 0;
+    int digitos = 0;
+    while ((unsigned)(p[digitos] - '0') < 10 && digitos <= CODEC_MAX_DIGITOS) {
+        valor = valor * 10 + (uint64_t)(p[digitos] - '0');
+        digitos++;
+    }
+    if (digitos == 0 || digitos > CODEC_MAX_DIGITOS || p[digitos] != '\0')
+        return CODEC_IRREGULAR | (hash_texto(id) >> 1);
+    return prefixo | ((uint64_t)digitos << CODEC_DESLOC_DIGITOS) | valor;
+}
+
+static inline bool codec_id_regular(uint64_t chave) {
+    return (chave & CODEC_IRREGULAR) == 0;
+}
+
+// Reconstroi o texto de uma chave regular; false para chaves irregulares
+static inline bool codec_id_decodificar(uint64_t chave, char* destino, size_t capacidade) {
+    if (!codec_id_regular(chave)) return false;
+    int digitos = (int)((chave >> CODEC_DESLOC_DIGITOS) & 0x1F);
+    unsigned long long valor = (unsigned long long)(chave & CODEC_MASCARA_VALOR);
+    int n = snprintf(destino, capacidade, "%s%0*llu", (chave & CODEC_PREFIXO_TRN) ? "TRN" : "T", digitos, valor);
+    return n > 0 && (size_t)n < capacidade;
+}
+
+// Igualdade: so chaves irregulares precisam olhar o texto
+static inline bool codec_id_iguais(uint64_t chave_a, const char* id_a, uint64_t chave_b, const char* id_b) {
+    return chave_a == chave_b && (codec_id_regular(chave_a) || strcmp(id_a, id_b) == 0);
+}
+
+// Ordem total: pela chave e, em empate de chaves irregulares, pelo texto
+static inline int codec_id_comparar(uint64_t chave_a, const char* id_a, uint64_t chave_b, const char* id_b) {
+    if (chave_a != chave_b) return chave_a < chave_b ? -1 : 1;
+    return codec_id_regular(chave_a) ? 0 : strcmp(id_a, id_b);
+}
+
+// Hash da chave para indexar tabelas (potencia de 2 via hash_balde)
+static inline uint64_t codec_id_hash(uint64_t chave, uint64_t semente) {
+    return hash_u64(chave, semente);
+}
+
+// Valor (amount) como inteiro na mesma ordem dos floats, para indices
+// ordenados por valor: positivos com o bit de sinal ligado, negativos com
+// todos os bits invertidos. -0 e +0 viram a mesma chave
+static inline uint32_t codec_valor(float valor) {
+    if (valor == 0) valor = 0;
+    uint32_t bits;
+    memcpy(&bits, &valor, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+#endif
@@ -0,0 +1,89 @@
+// Cursor em ordem para arvores binarias (AVL e afins), sem recursao: uma
+// pilha explicita guarda o caminho ate o no atual. Os nos ficam num vetor
+// (pool_indices.h) e os filhos sao indices de 32 bits, 0 = nenhum; serve
+// para qualquer struct de no, informando o tamanho dele e o deslocamento
+// dos indices esquerdo e direito.
+//
+// Percorrer com o cursor e so um laco: o chamador pode parar a qualquer
+// momento (nao ha nada a liberar) e nao paga uma chamada por no. Ao descer
+// pela borda esquerda de uma subarvore, o cursor ja pede ao processador os
+// filhos direitos empilhados, que sao os proximos nos a serem visitados.
+// A arvore nao pode mudar durante o percurso.
+#ifndef CURSOR_ARVORE_H
+#define CURSOR_ARVORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#define CURSOR_PREFETCH(p) _mm_prefetch((const char*)(p), _MM_HINT_T0)
+#else
+#define CURSOR_PREFETCH(p) __builtin_prefetch(p)
+#endif
+
+// Altura maxima da arvore: uma AVL com 64 niveis tem mais de 2^44 nos
+#define CURSOR_MAX_ALTURA 64
+
+typedef struct CursorArvore {
+    uint32_t pilha[CURSOR_MAX_ALTURA];
+    int topo;
+    unsigned char* nos;
+    size_t tamanho_no;
+    size_t deslocamento_esquerda;
+    size_t deslocamento_direita;
+} CursorArvore;
+
+static inline void* cursor_no(const CursorArvore* c, uint32_t i) {
+    return c->nos + (size_t)i * c->tamanho_no;
+}
+
+static inline uint32_t cursor_filho(const CursorArvore* c, uint32_t i, size_t deslocamento) {
+    return *(const uint32_t*)((const unsigned char*)cursor_no(c, i) + deslocamento);
+}
+
+// Empilha "i" e toda a sua borda esquerda
+static inline void cursor_descer(CursorArvore* c, uint32_t i) {
+    while (i && c->topo < CURSOR_MAX_ALTURA) {
+        c->pilha[c->topo++] = i;
+        uint32_t direito = cursor_filho(c, i, c->deslocamento_direita);
+        if (direito) CURSOR_PREFETCH(cursor_no(c, direito));
+        i = cursor_filho(c, i, c->deslocamento_esquerda);
+    }
+}
+
+// Proximo no em ordem, ou NULL no fim
+static inline void* cursor_proximo(CursorArvore* c) {
+    if (c->topo == 0) return NULL;
+    uint32_t i = c->pilha[--c->topo];
+    cursor_descer(c, cursor_filho(c, i, c->deslocamento_direita));
+    return cursor_no(c, i);
+}
+
+// Cursor vazio sobre o vetor de nos; cursor_primeiro ou cursor_empilhar o posicionam
+static inline void cursor_iniciar(CursorArvore* c, void* nos, size_t tamanho_no,
+                                  size_t deslocamento_esquerda, size_t deslocamento_direita) {
+    c->topo = 0;
+    c->nos = (unsigned char*)nos;
+    c->tamanho_no = tamanho_no;
+    c->deslocamento_esquerda = deslocamento_esquerda;
+    c->deslocamento_direita = deslocamento_direita;
+}
+
+// Empilha so o no "i": cursor_proximo o devolve e segue pela subarvore
+// direita dele. Para comecar numa chave, desca da raiz empilhando os nos
+// onde a descida vai para a esquerda; as subarvores abaixo da chave nem
+// entram na pilha
+static inline void cursor_empilhar(CursorArvore* c, uint32_t i) {
+    if (c->topo < CURSOR_MAX_ALTURA) c->pilha[c->topo++] = i;
+}
+
+// Posiciona no menor no da arvore com raiz "raiz" e o devolve (NULL se vazia)
+static inline void* cursor_primeiro(CursorArvore* c, void* nos, size_t tamanho_no, uint32_t raiz,
+                                    size_t deslocamento_esquerda, size_t deslocamento_direita) {
+    cursor_iniciar(c, nos, tamanho_no, deslocamento_esquerda, deslocamento_direita);
+    cursor_descer(c, raiz);
+    return cursor_proximo(c);
+}
+
+#endif
@@ -0,0 +1,280 @@
+// Filtro de Bloom bloqueado: os bits ficam empacotados em blocos de 512 bits
+// (uma linha de cache de 64 bytes) e todos os k bits de uma chave caem no
+// mesmo bloco, entao cada consulta custa um unico acesso a memoria.
+//
+// Tudo sai de um hash de 64 bits: os 32 bits altos escolhem o bloco e os 32
+// baixos geram as k posicoes, multiplicando por uma constante impar a cada
+// sonda (a sonda i usa x * M^i). Com AVX2 as 8 primeiras sondas sao testadas
+// de uma vez; sem AVX2 o teste e escalar, com o mesmo resultado.
+//
+// O tamanho e o k sao escolhidos por bloom_iniciar a partir do numero
+// esperado de chaves e da taxa de falsos positivos desejada, usando a
+// formula do filtro bloqueado (blocos recebem um numero Poisson de chaves).
+//
+// Com bloom_ativar_contagem o filtro ganha um contador de 4 bits por bit e
+// passa a aceitar remocoes: o bit so apaga quando o contador volta a zero.
+// Contadores que chegam a 15 ficam presos (saturados) e o bit nunca mais
+// apaga; bloom_precisa_reconstruir avisa quando chaves demais, ou bits
+// presos demais, levam a taxa estimada acima do limite.
+#ifndef FILTRO_BLOOM_H
+#define FILTRO_BLOOM_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BLOOM_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define BLOOM_SIMD_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BLOOM_ALVO_AVX2 __attribute__((target("avx2")))
+#else
+#define BLOOM_ALVO_AVX2
+#endif
+
+#define BLOOM_BITS_BLOCO 512
+#define BLOOM_PALAVRAS_BLOCO 16        // Palavras de 32 bits por bloco
+#define BLOOM_MAX_K 16
+#define BLOOM_MULTIPLICADOR 0x9E3779B9u // Impar: x * M^i percorre valores distintos
+#define BLOOM_CONTADOR_MAXIMO 15        // Contador de 4 bits saturado
+
+// ================= ESTRUTURAS =================
+
+typedef struct FiltroBloom {
+    uint32_t* blocos;        // num_blocos * 16 palavras, alinhado a 64 bytes
+    void* bruto;             // Ponteiro devolvido pelo malloc
+    uint32_t num_blocos;
+    int k;
+    uint32_t potencias[8];   // M^0 .. M^7, uma por pista do AVX2
+    uint32_t potencia_8;     // M^8, para continuar apos 8 sondas
+    size_t inseridos;        // Chaves presentes (insercoes menos remocoes)
+    size_t bits_ligados;
+    uint8_t* contadores;     // 2 contadores de 4 bits por byte; NULL sem contagem
+    size_t saturados;        // Contadores presos em BLOOM_CONTADOR_MAXIMO
+    size_t limite_chaves;    // Acima disso a taxa estimada passa do limite
+    size_t limite_bits;
+} FiltroBloom;
+
+// ================= FUNCOES AUXILIARES =================
+
+static inline uint32_t bloom_bloco(const FiltroBloom* f, uint64_t h) {
+    return (uint32_t)(((h >> 32) * (uint64_t)f->num_blocos) >> 32);
+}
+
+// Contador de 4 bits da posicao "indice" (bloco * 512 + bit)
+static inline unsigned bloom_contador(const FiltroBloom* f, size_t indice) {
+    return (f->contadores[indice >> 1] >> ((indice & 1) * 4)) & 0xF;
+}
+
+static inline void bloom_definir_contador(FiltroBloom* f, size_t indice, unsigned valor) {
+    int desloc = (int)(indice & 1) * 4;
+    f->contadores[indice >> 1] = (uint8_t)((f->contadores[indice >> 1] & ~(0xF << desloc)) | (valor << desloc));
+}
+
+// Taxa de falsos positivos de um filtro bloqueado com "chaves_por_bloco" em media
+static inline double bloom_fpr_modelo(double chaves_por_bloco, int k) {
+    double log_livre = log1p(-1.0 / BLOOM_BITS_BLOCO);
+    double p = exp(-chaves_por_bloco); // Poisson: P(j = 0)
+    double limite = chaves_por_bloco + 12.0 * sqrt(chaves_por_bloco) + 20.0;
+    double fpr = 0.0;
+    for (int j = 0; j <= (int)limite; j++) {
+        fpr += p * pow(1.0 - exp(k * j * log_livre), k);
+        p *= chaves_por_bloco / (j + 1);
+    }
+    return fpr;
+}
+
+static inline bool bloom_contem_escalar(const FiltroBloom* f, uint64_t h) {
+    const uint32_t* bloco = f->blocos + (size_t)bloom_bloco(f, h) * BLOOM_PALAVRAS_BLOCO;
+    uint32_t x = (uint32_t)h;
+    for (int i = 0; i < f->k; i++) {
+        uint32_t pos = x >> 23; // 9 bits: posicao dentro do bloco
+        if (!((bloco[pos >> 5] >> (pos & 31)) & 1)) return false;
+        x *= BLOOM_MULTIPLICADOR;
+    }
+    return true;
+}
+
+#if BLOOM_SIMD_X86
+// 8 sondas por vez: cada pista calcula sua posicao, escolhe a palavra do bloco
+// com permutevar (metade baixa ou alta conforme o bit 3) e testa o bit
+BLOOM_ALVO_AVX2 static inline bool bloom_contem_avx2(const FiltroBloom* f, uint64_t h) {
+    const uint32_t* bloco = f->blocos + (size_t)bloom_bloco(f, h) * BLOOM_PALAVRAS_BLOCO;
+    const __m256i baixa = _mm256_load_si256((const __m256i*)bloco);
+    const __m256i alta = _mm256_load_si256((const __m256i*)(bloco + 8));
+    const __m256i potencias = _mm256_loadu_si256((const __m256i*)f->potencias);
+    const __m256i pistas = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    uint32_t x = (uint32_t)h;
+    for (int restantes = f->k; restantes > 0; restantes -= 8) {
+        __m256i pos = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32((int)x), potencias), 23);
+        __m256i palavra = _mm256_srli_epi32(pos, 5);
+        __m256i escolhida = _mm256_blendv_epi8(_mm256_permutevar8x32_epi32(baixa, palavra),
+                                               _mm256_permutevar8x32_epi32(alta, palavra),
+                                               _mm256_cmpgt_epi32(palavra, _mm256_set1_epi32(7)));
+        __m256i bit = _mm256_sllv_epi32(_mm256_set1_epi32(1), _mm256_and_si256(pos, _mm256_set1_epi32(31)));
+        __m256i validas = _mm256_cmpgt_epi32(_mm256_set1_epi32(restantes), pistas);
+        __m256i faltando = _mm256_andnot_si256(escolhida, _mm256_and_si256(bit, validas));
+        if (!_mm256_testz_si256(faltando, faltando)) return false;
+        x *= f->potencia_8;
+    }
+    return true;
+}
+#endif
+
+typedef bool (*KernelBloom)(const FiltroBloom* f, uint64_t h);
+
+// Escolhe o teste uma unica vez, conforme a CPU
+static inline KernelBloom bloom_kernel_contem() {
+#if BLOOM_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+    static const KernelBloom kernel = __builtin_cpu_supports("avx2") ? bloom_contem_avx2 : bloom_contem_escalar;
+    return kernel;
+#elif BLOOM_SIMD_X86 && defined(__AVX2__)
+    return bloom_contem_avx2;
+#else
+    return bloom_contem_escalar;
+#endif
+}
+
+// ================= OPERACOES =================
+
+// Dimensiona para "chaves_esperadas" com falsos positivos ate "fpr_alvo":
+// procura o menor numero de bits por chave (e o k) que atinge o alvo
+static inline bool bloom_iniciar(FiltroBloom* f, size_t chaves_esperadas, double fpr_alvo) {
+    memset(f, 0, sizeof(*f));
+    if (chaves_esperadas == 0) chaves_esperadas = 1;
+    double bits_por_chave = 2.0;
+    int melhor_k = 1;
+    for (; bits_por_chave < 64.0; bits_por_chave += 0.25) {
+        double chaves_por_bloco = BLOOM_BITS_BLOCO / bits_por_chave;
+        double melhor = 1.0;
+        for (int k = 1; k <= BLOOM_MAX_K; k++) {
+            double fpr = bloom_fpr_modelo(chaves_por_bloco, k);
+            if (fpr < melhor) {
+                melhor = fpr;
+                melhor_k = k;
+            }
+        }
+        if (melhor <= fpr_alvo) break;
+    }
+
+    double blocos = ceil(chaves_esperadas * bits_por_chave / BLOOM_BITS_BLOCO);
+    if (blocos > 4294967295.0) return false;
+    f->num_blocos = (uint32_t)blocos;
+    f->k = melhor_k;
+    uint32_t p = 1;
+    for (int i = 0; i < 8; i++) {
+        f->potencias[i] = p;
+        p *= BLOOM_MULTIPLICADOR;
+    }
+    f->potencia_8 = p;
+    f->limite_chaves = f->limite_bits = SIZE_MAX; // Sem limite ate bloom_definir_limite
+
+    size_t bytes = (size_t)f->num_blocos * (BLOOM_BITS_BLOCO / 8);
+    f->bruto = calloc(bytes + 64, 1);
+    if (!f->bruto) return false;
+    f->blocos = (uint32_t*)(((uintptr_t)f->bruto + 63) & ~(uintptr_t)63);
+    return true;
+}
+
+static inline void bloom_liberar(FiltroBloom* f) {
+    free(f->bruto);
+    free(f->contadores);
+    memset(f, 0, sizeof(*f));
+}
+
+// Liga os contadores de 4 bits (antes de inserir qualquer chave)
+static inline bool bloom_ativar_contagem(FiltroBloom* f) {
+    f->contadores = (uint8_t*)calloc((size_t)f->num_blocos * BLOOM_BITS_BLOCO / 2, 1);
+    return f->contadores != NULL;
+}
+
+// Pre-calcula quando a taxa estimada passa de "fpr_limite", para a checagem
+// a cada operacao ser so duas comparacoes: por chaves presentes (modelo do
+// filtro bloqueado) e por bits ligados, que inclui os presos por saturacao
+static inline void bloom_definir_limite(FiltroBloom* f, double fpr_limite) {
+    double baixo = 0.0, alto = BLOOM_BITS_BLOCO; // Chaves por bloco
+    for (int i = 0; i < 50; i++) {
+        double meio = (baixo + alto) / 2;
+        if (bloom_fpr_modelo(meio, f->k) <= fpr_limite) baixo = meio;
+        else alto = meio;
+    }
+    f->limite_chaves = (size_t)(baixo * f->num_blocos);
+    f->limite_bits = (size_t)(pow(fpr_limite, 1.0 / f->k) * f->num_blocos * BLOOM_BITS_BLOCO);
+}
+
+static inline bool bloom_precisa_reconstruir(const FiltroBloom* f) {
+    return f->inseridos > f->limite_chaves || f->bits_ligados > f->limite_bits;
+}
+
+static inline void bloom_inserir(FiltroBloom* f, uint64_t h) {
+    size_t b = bloom_bloco(f, h);
+    uint32_t* bloco = f->blocos + b * BLOOM_PALAVRAS_BLOCO;
+    uint32_t x = (uint32_t)h;
+    for (int i = 0; i < f->k; i++) {
+        uint32_t pos = x >> 23;
+        uint32_t bit = 1u << (pos & 31);
+        if (!(bloco[pos >> 5] & bit)) {
+            bloco[pos >> 5] |= bit;
+            f->bits_ligados++;
+        }
+        if (f->contadores) {
+            size_t indice = b * BLOOM_BITS_BLOCO + pos;
+            unsigned valor = bloom_contador(f, indice);
+            if (valor < BLOOM_CONTADOR_MAXIMO) {
+                bloom_definir_contador(f, indice, valor + 1);
+                if (valor + 1 == BLOOM_CONTADOR_MAXIMO) f->saturados++;
+            }
+        }
+        x *= BLOOM_MULTIPLICADOR;
+    }
+    f->inseridos++;
+}
+
+// Remove uma chave que sabidamente foi inserida (exige a contagem ativa)
+static inline bool bloom_remover(FiltroBloom* f, uint64_t h) {
+    if (!f->contadores || f->inseridos == 0) return false;
+    size_t b = bloom_bloco(f, h);
+    uint32_t* bloco = f->blocos + b * BLOOM_PALAVRAS_BLOCO;
+    uint32_t x = (uint32_t)h;
+    for (int i = 0; i < f->k; i++) {
+        uint32_t pos = x >> 23;
+        size_t indice = b * BLOOM_BITS_BLOCO + pos;
+        unsigned valor = bloom_contador(f, indice);
+        if (valor > 0 && valor < BLOOM_CONTADOR_MAXIMO) {
+            bloom_definir_contador(f, indice, valor - 1);
+            if (valor == 1) {
+                bloco[pos >> 5] &= ~(1u << (pos & 31));
+                f->bits_ligados--;
+            }
+        }
+        x *= BLOOM_MULTIPLICADOR;
+    }
+    f->inseridos--;
+    return true;
+}
+
+static inline bool bloom_contem(const FiltroBloom* f, uint64_t h) {
+    return bloom_kernel_contem()(f, h);
+}
+
+// Taxa de falsos positivos esperada: o modelo pelas chaves presentes ou, se
+// maior, a fracao de bits ligados elevada a k (pega bits presos por saturacao)
+static inline double bloom_fpr_estimada(const FiltroBloom* f) {
+    double modelo = bloom_fpr_modelo((double)f->inseridos / f->num_blocos, f->k);
+    double ocupacao = pow((double)f->bits_ligados / ((double)f->num_blocos * BLOOM_BITS_BLOCO), f->k);
+    return modelo > ocupacao ? modelo : ocupacao;
+}
+
+static inline size_t bloom_memoria(const FiltroBloom* f) {
+    size_t bits = (size_t)f->num_blocos * BLOOM_BITS_BLOCO;
+    return sizeof(*f) + bits / 8 + (f->contadores ? bits / 2 : 0);
+}
+
+#endif
@@ -0,0 +1,277 @@
+// Filtro binary fuse de 8 bits (Graf e Lemire, 2022): filtro imutavel,
+// construido uma vez sobre um conjunto fixo de chaves de 64 bits. Cada chave
+// mapeia para 3 posicoes de um array de impressoes de 8 bits, em 3 segmentos
+// vizinhos; a chave "esta" se o xor das tres impressoes da a impressao dela.
+// Usa ~9 bits por chave para ~0,39% de falsos positivos (1/256), contra ~10
+// bits por chave para 1% no Bloom bloqueado, mas nao aceita insercoes nem
+// remocoes: serve para o replay somente leitura de um dataset.
+//
+// O filtro pode ser gravado ao lado do dataset e recarregado; o cabecalho
+// guarda tamanho e data do CSV, como o snapshot .fdb.
+#ifndef FILTRO_FUSE_H
+#define FILTRO_FUSE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include "hash_rapido.h"
+
+#define FUSE_VERSAO 2
+#define FUSE_ARIDADE 3
+#define FUSE_MAX_SEGMENTO 262144u // 2^18: as posicoes usam 18 bits do hash cada
+#define FUSE_MAX_TENTATIVAS 100
+
+// ================= ESTRUTURAS =================
+
+typedef struct FiltroFuse {
+    uint64_t semente;
+    uint32_t tamanho_segmento;     // Potencia de 2
+    uint32_t mascara_segmento;
+    uint32_t num_segmentos;        // Segmentos onde a primeira posicao pode cair
+    uint32_t comprimento_inicio;   // num_segmentos * tamanho_segmento
+    uint32_t tamanho;              // Impressoes no array
+    uint32_t num_chaves;
+    uint8_t* impressoes;
+} FiltroFuse;
+
+typedef struct CabecalhoFuse {
+    char magica[4];                // "FUS8"
+    uint32_t versao;
+    uint64_t tamanho_csv;          // Dataset de origem, para descartar o
+    int64_t modificacao_csv;       // filtro gravado quando o CSV mudar
+    uint64_t semente;
+    uint32_t tamanho_segmento;
+    uint32_t num_segmentos;
+    uint32_t tamanho;
+    uint32_t num_chaves;           // Chaves distintas no filtro
+    uint32_t num_entradas;         // Chaves entregues a fuse_construir, com repeticoes
+} CabecalhoFuse;
+
+// ================= FUNCOES AUXILIARES =================
+
+static inline uint64_t fuse_misturar(uint64_t chave, uint64_t semente) {
+    return hash_u64(chave, semente);
+}
+
+static inline uint8_t fuse_impressao(uint64_t h) {
+    return (uint8_t)(h ^ (h >> 32));
+}
+
+// Posicao "i" (0, 1 ou 2) da chave: inicio uniforme em [0, comprimento_inicio)
+// e as outras nos dois segmentos seguintes, deslocadas por 18 bits do hash
+static inline uint32_t fuse_posicao(const FiltroFuse* f, int i, uint64_t h) {
+    uint64_t inicio = h, alto = f->comprimento_inicio;
+    hash_mum128(&inicio, &alto); // alto = (h * comprimento_inicio) >> 64
+    uint64_t p = alto + (uint64_t)i * f->tamanho_segmento;
+    p ^= ((h & ((1ull << 36) - 1)) >> (36 - 18 * i)) & f->mascara_segmento;
+    return (uint32_t)p;
+}
+
+static inline void fuse_posicoes(const FiltroFuse* f, uint64_t h, uint32_t posicoes[FUSE_ARIDADE]) {
+    for (int i = 0; i < FUSE_ARIDADE; i++) posicoes[i] = fuse_posicao(f, i, h);
+}
+
+// Parametros empiricos do artigo para aridade 3
+static inline void fuse_dimensionar(FiltroFuse* f, uint32_t n) {
+    f->tamanho_segmento = n == 0 ? 4 : 1u << (int)floor(log((double)n) / log(3.33) + 2.25);
+    if (f->tamanho_segmento > FUSE_MAX_SEGMENTO) f->tamanho_segmento = FUSE_MAX_SEGMENTO;
+    f->mascara_segmento = f->tamanho_segmento - 1;
+    double fator = n <= 1 ? 0.0 : fmax(1.125, 0.875 + 0.25 * log(1000000.0) / log((double)n));
+    uint32_t capacidade = (uint32_t)round(n * fator);
+    uint32_t segmentos = (capacidade + f->tamanho_segmento - 1) / f->tamanho_segmento;
+    f->num_segmentos = segmentos > FUSE_ARIDADE - 1 ? segmentos - (FUSE_ARIDADE - 1) : 1;
+    f->tamanho = (f->num_segmentos + FUSE_ARIDADE - 1) * f->tamanho_segmento;
+    f->comprimento_inicio = f->num_segmentos * f->tamanho_segmento;
+    f->num_chaves = n;
+}
+
+static inline int fuse_comparar_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+// ================= OPERACOES =================
+
+// Constroi o filtro sobre "chaves" (o array e ordenado e perde as repeticoes).
+// Cada posicao guarda quantas chaves a usam e o xor dos hashes delas; posicoes
+// com uma unica chave sao "descascadas" numa pilha, e as impressoes sao
+// preenchidas na ordem inversa. Se sobrar um ciclo, tenta outra semente.
+static inline bool fuse_construir(FiltroFuse* f, uint64_t* chaves, size_t quantidade) {
+    memset(f, 0, sizeof(*f));
+    qsort(chaves, quantidade, sizeof(uint64_t), fuse_comparar_u64);
+    size_t n = 0;
+    for (size_t i = 0; i < quantidade; i++)
+        if (n == 0 || chaves[n - 1] != chaves[i]) chaves[n++] = chaves[i];
+    if (n > 0xFFFFFFFFu / 2) return false;
+
+    fuse_dimensionar(f, (uint32_t)n);
+    f->impressoes = (uint8_t*)calloc(f->tamanho, 1);
+    uint8_t* contagem = (uint8_t*)malloc(f->tamanho);   // Chaves na posicao (satura em 255)
+    uint8_t* qual = (uint8_t*)malloc(f->tamanho);       // Xor dos indices i (0..2) das chaves
+    uint64_t* xor_hash = (uint64_t*)malloc(f->tamanho * sizeof(uint64_t));
+    uint32_t* fila = (uint32_t*)malloc(f->tamanho * sizeof(uint32_t));
+    uint64_t* pilha_hash = (uint64_t*)malloc((n + 1) * sizeof(uint64_t));
+    uint8_t* pilha_qual = (uint8_t*)malloc(n + 1);
+    bool ok = f->impressoes && contagem && qual && xor_hash && fila && pilha_hash && pilha_qual;
+
+    size_t empilhados = 0;
+    for (int tentativa = 0; ok; tentativa++) {
+        if (tentativa == FUSE_MAX_TENTATIVAS) {
+            ok = false;
+            break;
+        }
+        f->semente = hash_u64((uint64_t)tentativa, HASH_P2);
+        memset(contagem, 0, f->tamanho);
+        memset(qual, 0, f->tamanho);
+        memset(xor_hash, 0, f->tamanho * sizeof(uint64_t));
+
+        bool estourou = false;
+        for (size_t j = 0; j < n; j++) {
+            uint64_t h = fuse_misturar(chaves[j], f->semente);
+            uint32_t p[FUSE_ARIDADE];
+            fuse_posicoes(f, h, p);
+            for (int i = 0; i < FUSE_ARIDADE; i++) {
+                if (contagem[p[i]] == 255) estourou = true;
+                contagem[p[i]]++;
+                qual[p[i]] ^= (uint8_t)i;
+                xor_hash[p[i]] ^= h;
+            }
+        }
+        if (estourou) continue;
+
+        size_t tamanho_fila = 0;
+        for (uint32_t p = 0; p < f->tamanho; p++)
+            if (contagem[p] == 1) fila[tamanho_fila++] = p;
+
+        empilhados = 0;
+        while (tamanho_fila > 0) {
+            uint32_t p = fila[--tamanho_fila];
+            if (contagem[p] != 1) continue; // Ja descascada por outra chave
+            uint64_t h = xor_hash[p];
+            uint8_t i_sozinha = qual[p];
+            pilha_hash[empilhados] = h;
+            pilha_qual[empilhados++] = i_sozinha;
+
+            uint32_t posicoes[FUSE_ARIDADE];
+            fuse_posicoes(f, h, posicoes);
+            for (int i = 0; i < FUSE_ARIDADE; i++) {
+                uint32_t q = posicoes[i];
+                contagem[q]--;
+                qual[q] ^= (uint8_t)i;
+                xor_hash[q] ^= h;
+                if (i != i_sozinha && contagem[q] == 1) fila[tamanho_fila++] = q;
+            }
+        }
+        if (empilhados == n) break;
+    }
+
+    // Ordem inversa: cada chave acerta a unica posicao ainda livre dela
+    for (size_t j = empilhados; ok && j-- > 0;) {
+        uint64_t h = pilha_hash[j];
+        uint32_t p[FUSE_ARIDADE];
+        fuse_posicoes(f, h, p);
+        uint8_t livre = pilha_qual[j];
+        uint8_t valor = fuse_impressao(h);
+        for (int i = 0; i < FUSE_ARIDADE; i++)
+            if (i != livre) valor ^= f->impressoes[p[i]];
+        f->impressoes[p[livre]] = valor;
+    }
+
+    free(contagem);
+    free(qual);
+    free(xor_hash);
+    free(fila);
+    free(pilha_hash);
+    free(pilha_qual);
+    if (!ok) {
+        free(f->impressoes);
+        memset(f, 0, sizeof(*f));
+    }
+    return ok;
+}
+
+static inline bool fuse_contem(const FiltroFuse* f, uint64_t chave) {
+    uint64_t h = fuse_misturar(chave, f->semente);
+    uint32_t p[FUSE_ARIDADE];
+    fuse_posicoes(f, h, p);
+    return (uint8_t)(fuse_impressao(h) ^ f->impressoes[p[0]] ^ f->impressoes[p[1]] ^ f->impressoes[p[2]]) == 0;
+}
+
+static inline void fuse_liberar(FiltroFuse* f) {
+    free(f->impressoes);
+    memset(f, 0, sizeof(*f));
+}
+
+static inline size_t fuse_memoria(const FiltroFuse* f) {
+    return sizeof(*f) + f->tamanho;
+}
+
+// ================= GRAVACAO E LEITURA =================
+
+// Grava num temporario e renomeia, como o snapshot .fdb. "num_entradas" e a
+// quantidade de chaves (com repeticoes) de onde o filtro saiu: o chamador
+// sabe essa contagem antes de montar qualquer coisa, e e ela que fuse_carregar
+// confere
+static inline bool fuse_gravar(const FiltroFuse* f, const char* caminho, uint64_t tamanho_csv, int64_t modificacao_csv,
+                               uint32_t num_entradas) {
+    char temporario[1024];
+    if (strlen(caminho) + 5 > sizeof(temporario)) return false;
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+
+    CabecalhoFuse cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, "FUS8", 4);
+    cab.versao = FUSE_VERSAO;
+    cab.tamanho_csv = tamanho_csv;
+    cab.modificacao_csv = modificacao_csv;
+    cab.semente = f->semente;
+    cab.tamanho_segmento = f->tamanho_segmento;
+    cab.num_segmentos = f->num_segmentos;
+    cab.tamanho = f->tamanho;
+    cab.num_chaves = f->num_chaves;
+    cab.num_entradas = num_entradas;
+
+    FILE* arquivo = fopen(temporario, "wb");
+    if (!arquivo) return false;
+    bool ok = fwrite(&cab, sizeof(cab), 1, arquivo) == 1 &&
+              fwrite(f->impressoes, 1, f->tamanho, arquivo) == f->tamanho;
+    ok = fclose(arquivo) == 0 && ok;
+    if (ok) {
+        remove(caminho); // rename nao sobrescreve no Windows
+        ok = rename(temporario, caminho) == 0;
+    }
+    if (!ok) remove(temporario);
+    return ok;
+}
+
+// Carrega um filtro gravado para o mesmo CSV e o mesmo numero de entradas
+// (ver fuse_gravar); qualquer divergencia devolve false e o chamador reconstroi
+static inline bool fuse_carregar(FiltroFuse* f, const char* caminho, uint64_t tamanho_csv, int64_t modificacao_csv,
+                                 uint32_t num_entradas) {
+    memset(f, 0, sizeof(*f));
+    FILE* arquivo = fopen(caminho, "rb");
+    if (!arquivo) return false;
+
+    CabecalhoFuse cab;
+    bool ok = fread(&cab, sizeof(cab), 1, arquivo) == 1 && memcmp(cab.magica, "FUS8", 4) == 0 &&
+              cab.versao == FUSE_VERSAO && cab.tamanho_csv == tamanho_csv &&
+              cab.modificacao_csv == modificacao_csv && cab.num_entradas == num_entradas;
+    if (ok) {
+        fuse_dimensionar(f, cab.num_chaves);
+        ok = f->tamanho_segmento == cab.tamanho_segmento && f->num_segmentos == cab.num_segmentos &&
+             f->tamanho == cab.tamanho;
+    }
+    if (ok) {
+        f->semente = cab.semente;
+        f->impressoes = (uint8_t*)malloc(f->tamanho);
+        ok = f->impressoes && fread(f->impressoes, 1, f->tamanho, arquivo) == f->tamanho;
+    }
+    fclose(arquivo);
+    if (!ok) fuse_liberar(f);
+    return ok;
+}
+
+#endif
@@ -0,0 +1,156 @@
+// Funcoes de hash de 64 bits compartilhadas pelas estruturas do trabalho.
+// O nucleo segue o desenho do wyhash: le a chave 8 bytes por vez e mistura com
+// uma multiplicacao 64x64 -> 128 bits, o que espalha bem todos os bits da
+// saida. Por isso as tabelas podem usar tamanho potencia de 2 e pegar o balde
+// com uma mascara (h & (tamanho - 1)) em vez do modulo por um primo.
+//
+// As tabelas de transacoes hasheiam a chave inteira do transaction_id
+// (codec_id.h) com hash_u64; as funcoes de texto cobrem IDs irregulares e
+// ficam no Benchmark_Hash para comparacao.
+#ifndef HASH_RAPIDO_H
+#define HASH_RAPIDO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+static const uint64_t HASH_P0 = 0xa0761d6478bd642full;
+static const uint64_t HASH_P1 = 0xe7037ed1a0b428dbull;
+static const uint64_t HASH_P2 = 0x8ebc6af09c88c6e3ull;
+
+// Produto de 128 bits de *a e *b: *a recebe a metade baixa e *b a alta
+static inline void hash_mum128(uint64_t* a, uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline uint64_t hash_mum(uint64_t a, uint64_t b) {
+    hash_mum128(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t hash_ler64(const unsigned char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t hash_ler32(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Hash de um bloco qualquer de bytes; nunca le fora de p[0..n)
+static inline uint64_t hash_bytes(const void* dados, size_t n, uint64_t semente) {
+    const unsigned char* p = (const unsigned char*)dados;
+    uint64_t a, b;
+    semente ^= hash_mum(semente ^ HASH_P0, HASH_P1);
+    if (n <= 16) {
+        if (n >= 4) {
+            size_t meio = (n >> 3) << 2;
+            a = (hash_ler32(p) << 32) | hash_ler32(p + meio);
+            b = (hash_ler32(p + n - 4) << 32) | hash_ler32(p + n - 4 - meio);
+        } else if (n > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[n >> 1] << 8) | p[n - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t resto = n;
+        while (resto > 16) {
+            semente = hash_mum(hash_ler64(p) ^ HASH_P1, hash_ler64(p + 8) ^ semente);
+            p += 16;
+            resto -= 16;
+        }
+        a = hash_ler64(p + resto - 16); // Ultimos 16 bytes (n > 16, entao validos)
+        b = hash_ler64(p + resto - 8);
+    }
+    a ^= HASH_P1;
+    b ^= semente;
+    hash_mum128(&a, &b);
+    return hash_mum(a ^ HASH_P0 ^ (uint64_t)n, b ^ HASH_P1);
+}
+
+// Hash de uma string terminada em '\0'
+static inline uint64_t hash_texto(const char* s) {
+    return hash_bytes(s, strlen(s), 0);
+}
+
+static inline uint64_t hash_texto_semente(const char* s, uint64_t semente) {
+    return hash_bytes(s, strlen(s), semente);
+}
+
+// Hash de uma chave inteira (ex.: transaction_id codificado por codec_id.h)
+static inline uint64_t hash_u64(uint64_t x, uint64_t semente) {
+    return hash_mum(x ^ HASH_P0 ^ semente, hash_mum(x ^ HASH_P1, HASH_P2 ^ semente));
+}
+
+// 16 bytes 0xFF seguidos de 16 zeros: ler a partir de HASH_MASCARA + 16 - n
+// da uma mascara com os n primeiros bytes ligados, em qualquer endianness
+static const unsigned char HASH_MASCARA[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+// Hash de um transaction_id guardado num buffer de pelo menos 16 bytes
+// (char transaction_id[16] dos structs). Le o buffer como duas palavras de
+// 64 bits e zera o que vem depois do '\0', entao lixo apos o terminador nao
+// muda o resultado. So os 16 primeiros bytes entram no hash.
+static inline uint64_t hash_id16(const char* id) {
+    const unsigned char* p = (const unsigned char*)id;
+    const void* zero = memchr(p, '\0', 16);
+    size_t n = zero ? (size_t)((const unsigned char*)zero - p) : 16;
+    uint64_t a = hash_ler64(p) & hash_ler64(HASH_MASCARA + 16 - n);
+    uint64_t b = hash_ler64(p + 8) & hash_ler64(HASH_MASCARA + 16 - (n > 8 ? n - 8 : 0));
+    a ^= HASH_P1;
+    b ^= HASH_P2 ^ (uint64_t)n;
+    hash_mum128(&a, &b);
+    return hash_mum(a ^ HASH_P0, b ^ HASH_P1);
+}
+
+// ---- Funcoes antigas, mantidas para comparacao no benchmark ----
+
+static inline uint64_t hash_djb2(const char* s) {
+    uint32_t h = 5381;
+    int c;
+    while ((c = (unsigned char)*s++))
+        h = ((h << 5) + h) + c;
+    return h;
+}
+
+static inline uint64_t hash_fnv1a(const char* s) {
+    uint64_t h = 14695981039346656037ull;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+typedef uint64_t (*FuncaoHash)(const char* chave);
+
+// Balde de uma tabela com "tamanho" potencia de 2
+static inline size_t hash_balde(uint64_t h, size_t tamanho) {
+    return (size_t)h & (tamanho - 1);
+}
+
+#endif
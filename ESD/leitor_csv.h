@@ -0,0 +1,725 @@
+// Leitor de CSV compartilhado pelas estruturas do trabalho.
+// O arquivo e mapeado em memoria e os campos sao localizados no proprio
+// mapeamento: nenhuma linha e copiada e nao ha sscanf. Cada campo e entregue
+// como uma visao (ponteiro + tamanho) para dentro do arquivo.
+#ifndef LEITOR_CSV_H
+#define LEITOR_CSV_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <errno.h>
+#include <stdint.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CSV_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define CSV_SIMD_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CSV_ALVO_AVX2 __attribute__((target("avx2")))
+#else
+#define CSV_ALVO_AVX2
+#endif
+
+// Colunas usadas do dataset: transaction_id, timestamp, sender_account,
+// receiver_account, amount, transaction_type, merchant_category, location,
+// device_used, is_fraud. Colunas extras no fim da linha sao ignoradas.
+#define CSV_NUM_CAMPOS 10
+
+#define CAMPO_ID         0
+#define CAMPO_TIMESTAMP  1
+#define CAMPO_SENDER     2
+#define CAMPO_RECEIVER   3
+#define CAMPO_AMOUNT     4
+#define CAMPO_TIPO       5
+#define CAMPO_CATEGORIA  6
+#define CAMPO_LOCAL      7
+#define CAMPO_DISPOSITIVO 8
+#define CAMPO_FRAUDE     9
+
+// Modo de carga: CSV_THREADS_AUTO usa todos os nucleos, 1 le sequencialmente
+#define CSV_THREADS_AUTO 0
+#define CSV_TAMANHO_BLOCO (4u << 20) // Bytes por bloco na carga paralela
+#define CSV_JANELA 32768              // Bytes indexados por vez pelo kernel SIMD
+#define CSV_LINHAS_TABELA 512         // Linhas por tabela de offsets
+#define CSV_AMOSTRA_ESTIMATIVA (1u << 20) // Bytes lidos para estimar o numero de linhas
+
+// ================= ESTRUTURAS =================
+
+// Visao de um campo dentro do arquivo mapeado (nao termina em '\0')
+typedef struct CampoCSV {
+    const char* inicio;
+    size_t tamanho;
+} CampoCSV;
+
+// Uma linha do dataset ja separada em campos
+typedef struct LinhaCSV {
+    CampoCSV campos[CSV_NUM_CAMPOS];
+    int num_campos;      // Campos encontrados (no maximo CSV_NUM_CAMPOS)
+    const char* inicio;  // Linha inteira, usada nas mensagens de erro
+    size_t tamanho;
+    bool amount_pronto;  // Amount ja convertido (snapshot .fdb); no CSV vem do texto
+    float amount;
+} LinhaCSV;
+
+// Arquivo inteiro mapeado somente para leitura
+typedef struct ArquivoMapeado {
+    const char* dados;
+    size_t tamanho;
+#ifdef _WIN32
+    HANDLE arquivo;
+    HANDLE mapeamento;
+#endif
+} ArquivoMapeado;
+
+// Offsets de uma linha, relativos ao inicio da janela indexada
+typedef struct OffsetsLinha {
+    uint16_t inicio_campo[CSV_NUM_CAMPOS];
+    uint16_t fim_ultimo; // Fim do ultimo campo registrado
+    uint16_t inicio_linha;
+    uint16_t fim_linha;
+    uint8_t num_campos;
+} OffsetsLinha;
+
+// Tabela de offsets de uma janela do arquivo
+typedef struct TabelaCSV {
+    const char* base;
+    OffsetsLinha linhas[CSV_LINHAS_TABELA];
+    int quantidade;
+    int proxima; // Proxima linha a ser entregue
+} TabelaCSV;
+
+typedef struct LeitorCSV {
+    ArquivoMapeado arquivo;
+    const char* atual; // Inicio da proxima linha ainda nao indexada
+    const char* fim;
+    TabelaCSV tabela;
+} LeitorCSV;
+
+// ================= MAPEAMENTO DO ARQUIVO =================
+
+static inline bool mapear_arquivo(ArquivoMapeado* m, const char* caminho) {
+    m->dados = NULL;
+    m->tamanho = 0;
+#ifdef _WIN32
+    m->mapeamento = NULL;
+    m->arquivo = CreateFileA(caminho, GENERIC_READ, FILE_SHARE_READ, NULL,
+                             OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (m->arquivo == INVALID_HANDLE_VALUE) {
+        DWORD erro = GetLastError();
+        errno = (erro == ERROR_FILE_NOT_FOUND || erro == ERROR_PATH_NOT_FOUND) ? ENOENT : EACCES;
+        return false;
+    }
+    LARGE_INTEGER tamanho;
+    if (!GetFileSizeEx(m->arquivo, &tamanho)) {
+        CloseHandle(m->arquivo);
+        errno = EIO;
+        return false;
+    }
+    m->tamanho = (size_t)tamanho.QuadPart;
+    if (m->tamanho == 0) return true; // Arquivo vazio nao pode ser mapeado
+
+    m->mapeamento = CreateFileMappingA(m->arquivo, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!m->mapeamento) {
+        CloseHandle(m->arquivo);
+        errno = ENOMEM;
+        return false;
+    }
+    m->dados = (const char*)MapViewOfFile(m->mapeamento, FILE_MAP_READ, 0, 0, 0);
+    if (!m->dados) {
+        CloseHandle(m->mapeamento);
+        CloseHandle(m->arquivo);
+        errno = ENOMEM;
+        return false;
+    }
+#else
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    m->tamanho = (size_t)info.st_size;
+    if (m->tamanho == 0) {
+        close(fd);
+        return true;
+    }
+
+    void* p = mmap(NULL, m->tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // O mapeamento continua valido apos fechar o descritor
+    if (p == MAP_FAILED) return false;
+    madvise(p, m->tamanho, MADV_SEQUENTIAL);
+    m->dados = (const char*)p;
+#endif
+    return true;
+}
+
+static inline void desmapear_arquivo(ArquivoMapeado* m) {
+#ifdef _WIN32
+    if (m->dados) UnmapViewOfFile(m->dados);
+    if (m->mapeamento) CloseHandle(m->mapeamento);
+    if (m->arquivo != INVALID_HANDLE_VALUE) CloseHandle(m->arquivo);
+    m->mapeamento = NULL;
+    m->arquivo = INVALID_HANDLE_VALUE;
+#else
+    if (m->dados) munmap((void*)m->dados, m->tamanho);
+#endif
+    m->dados = NULL;
+    m->tamanho = 0;
+}
+
+// ================= LOCALIZACAO DE DELIMITADORES (SIMD) =================
+
+// Marca em "mapa" (1 bit por byte) as posicoes de ',' e '\n' em p[0..n).
+// Cada palavra de 64 bits cobre 64 bytes do arquivo.
+typedef void (*KernelDelimitadores)(const char* p, size_t n, uint64_t* mapa);
+
+static inline uint64_t csv_mascara_escalar(const char* p, size_t n) {
+    uint64_t m = 0;
+    for (size_t i = 0; i < n; i++)
+        m |= (uint64_t)(p[i] == ',' || p[i] == '\n') << i;
+    return m;
+}
+
+static inline void csv_delimitadores_escalar(const char* p, size_t n, uint64_t* mapa) {
+    for (size_t i = 0; i < n; i += 64)
+        *mapa++ = csv_mascara_escalar(p + i, n - i < 64 ? n - i : 64);
+}
+
+#if CSV_SIMD_X86
+// SSE2 (presente em todo x86-64): quatro comparacoes de 16 bytes por palavra
+static inline void csv_delimitadores_sse2(const char* p, size_t n, uint64_t* mapa) {
+    const __m128i virgula = _mm_set1_epi8(',');
+    const __m128i quebra = _mm_set1_epi8('\n');
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        uint64_t m = 0;
+        for (int k = 0; k < 4; k++) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(p + i + 16 * k));
+            __m128i d = _mm_or_si128(_mm_cmpeq_epi8(v, virgula), _mm_cmpeq_epi8(v, quebra));
+            m |= (uint64_t)(uint16_t)_mm_movemask_epi8(d) << (16 * k);
+        }
+        *mapa++ = m;
+    }
+    if (i < n) *mapa = csv_mascara_escalar(p + i, n - i);
+}
+
+// AVX2: duas comparacoes de 32 bytes por palavra
+CSV_ALVO_AVX2 static inline void csv_delimitadores_avx2(const char* p, size_t n, uint64_t* mapa) {
+    const __m256i virgula = _mm256_set1_epi8(',');
+    const __m256i quebra = _mm256_set1_epi8('\n');
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(p + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(p + i + 32));
+        __m256i da = _mm256_or_si256(_mm256_cmpeq_epi8(a, virgula), _mm256_cmpeq_epi8(a, quebra));
+        __m256i db = _mm256_or_si256(_mm256_cmpeq_epi8(b, virgula), _mm256_cmpeq_epi8(b, quebra));
+        *mapa++ = (uint64_t)(uint32_t)_mm256_movemask_epi8(da) |
+                  ((uint64_t)(uint32_t)_mm256_movemask_epi8(db) << 32);
+    }
+    if (i < n) *mapa = csv_mascara_escalar(p + i, n - i);
+}
+#endif
+
+// Escolhe o kernel uma unica vez, conforme a CPU
+static inline KernelDelimitadores csv_kernel_delimitadores() {
+#if CSV_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+    static const KernelDelimitadores kernel =
+        __builtin_cpu_supports("avx2") ? csv_delimitadores_avx2 : csv_delimitadores_sse2;
+    return kernel;
+#elif CSV_SIMD_X86 && defined(__AVX2__)
+    return csv_delimitadores_avx2;
+#elif CSV_SIMD_X86
+    return csv_delimitadores_sse2;
+#else
+    return csv_delimitadores_escalar;
+#endif
+}
+
+static inline int csv_contar_zeros(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return (int)i;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+// Indexa as linhas completas a partir de leitor->atual na tabela de offsets.
+// Percorre so os bits marcados pelo kernel; para quando a janela ou a
+// tabela acabam. Retorna o numero de linhas indexadas.
+static inline int csv_indexar(LeitorCSV* leitor) {
+    TabelaCSV* tabela = &leitor->tabela;
+    const char* base = leitor->atual;
+    size_t n = (size_t)(leitor->fim - base);
+    bool ultima_janela = n <= CSV_JANELA;
+    if (!ultima_janela) n = CSV_JANELA;
+
+    uint64_t mapa[CSV_JANELA / 64];
+    csv_kernel_delimitadores()(base, n, mapa);
+
+    tabela->base = base;
+    tabela->quantidade = 0;
+    tabela->proxima = 0;
+
+    OffsetsLinha* linha = &tabela->linhas[0];
+    uint16_t inicio_linha = 0;
+    int campo = 0;
+    bool fechado = false;
+    linha->inicio_campo[0] = 0;
+
+    for (size_t w = 0; w * 64 < n; w++) {
+        uint64_t bits = mapa[w];
+        while (bits) {
+            uint16_t pos = (uint16_t)(w * 64 + csv_contar_zeros(bits));
+            bits &= bits - 1;
+            if (base[pos] == ',') {
+                if (campo < CSV_NUM_CAMPOS - 1) {
+                    linha->inicio_campo[++campo] = pos + 1;
+                } else if (!fechado) {
+                    linha->fim_ultimo = pos; // Colunas extras sao ignoradas
+                    fechado = true;
+                }
+                continue;
+            }
+
+            // Fim de linha
+            uint16_t fim_linha = pos;
+            if (!fechado) linha->fim_ultimo = pos;
+            if (fim_linha > inicio_linha && base[fim_linha - 1] == '\r') {
+                if (linha->fim_ultimo == fim_linha) linha->fim_ultimo--;
+                fim_linha--;
+            }
+            if (fim_linha > inicio_linha) { // Linhas vazias sao puladas
+                linha->inicio_linha = inicio_linha;
+                linha->fim_linha = fim_linha;
+                linha->num_campos = (uint8_t)(campo + 1);
+                if (++tabela->quantidade == CSV_LINHAS_TABELA) {
+                    leitor->atual = base + pos + 1;
+                    return tabela->quantidade;
+                }
+                linha = &tabela->linhas[tabela->quantidade];
+            }
+            inicio_linha = pos + 1;
+            campo = 0;
+            fechado = false;
+            linha->inicio_campo[0] = inicio_linha;
+        }
+    }
+
+    // Ultima linha do arquivo sem '\n' no final
+    if (ultima_janela && inicio_linha < n) {
+        uint16_t fim_linha = (uint16_t)n;
+        if (!fechado) linha->fim_ultimo = fim_linha;
+        if (base[fim_linha - 1] == '\r') {
+            if (linha->fim_ultimo == fim_linha) linha->fim_ultimo--;
+            fim_linha--;
+        }
+        if (fim_linha > inicio_linha) {
+            linha->inicio_linha = inicio_linha;
+            linha->fim_linha = fim_linha;
+            linha->num_campos = (uint8_t)(campo + 1);
+            tabela->quantidade++;
+        }
+        inicio_linha = (uint16_t)n;
+    }
+
+    leitor->atual = base + inicio_linha;
+    return tabela->quantidade;
+}
+
+// ================= LEITURA DE LINHAS =================
+
+// Abre o CSV e posiciona o leitor apos o cabecalho
+static inline bool csv_abrir(LeitorCSV* leitor, const char* caminho) {
+    if (!mapear_arquivo(&leitor->arquivo, caminho)) return false;
+
+    leitor->atual = leitor->arquivo.dados;
+    leitor->fim = leitor->arquivo.dados + leitor->arquivo.tamanho;
+
+    const char* fim_cabecalho = leitor->atual
+        ? (const char*)memchr(leitor->atual, '\n', leitor->fim - leitor->atual)
+        : NULL;
+    leitor->atual = fim_cabecalho ? fim_cabecalho + 1 : leitor->fim;
+    leitor->tabela.quantidade = leitor->tabela.proxima = 0;
+    return true;
+}
+
+// Restringe o leitor a um trecho [inicio, fim) que comeca no inicio de uma linha
+static inline void csv_intervalo(LeitorCSV* leitor, const char* inicio, const char* fim) {
+    leitor->arquivo.dados = NULL;
+    leitor->arquivo.tamanho = 0;
+    leitor->atual = inicio;
+    leitor->fim = fim;
+    leitor->tabela.quantidade = leitor->tabela.proxima = 0;
+}
+
+static inline void csv_fechar(LeitorCSV* leitor) {
+    desmapear_arquivo(&leitor->arquivo);
+    leitor->atual = leitor->fim = NULL;
+}
+
+// Numero aproximado de linhas de dados, para dimensionar estruturas antes da
+// carga: conta as quebras no comeco do arquivo e extrapola pelo tamanho
+// (exato se o arquivo couber na amostra). Retorna 0 se nao abrir.
+static inline size_t csv_estimar_linhas(const char* caminho) {
+    ArquivoMapeado m;
+    if (!mapear_arquivo(&m, caminho)) return 0;
+    size_t amostra = m.tamanho < CSV_AMOSTRA_ESTIMATIVA ? m.tamanho : CSV_AMOSTRA_ESTIMATIVA;
+    size_t quebras = 0;
+    const char* p = m.dados;
+    const char* fim = m.dados + amostra;
+    while (p < fim && (p = (const char*)memchr(p, '\n', fim - p)) != NULL) {
+        quebras++;
+        p++;
+    }
+    size_t linhas;
+    if (amostra == m.tamanho)
+        linhas = quebras + (amostra > 0 && m.dados[amostra - 1] != '\n');
+    else
+        linhas = (size_t)((double)quebras * m.tamanho / amostra);
+    desmapear_arquivo(&m);
+    return linhas > 0 ? linhas - 1 : 0; // Sem o cabecalho
+}
+
+// Separa uma linha localizando as virgulas com memchr. Usada apenas para
+// linhas maiores que a janela do indexador.
+static inline void csv_separar_linha(const char* inicio, const char* fim_linha, LinhaCSV* linha) {
+    linha->inicio = inicio;
+    linha->tamanho = (size_t)(fim_linha - inicio);
+    linha->num_campos = 0;
+    linha->amount_pronto = false;
+
+    const char* p = inicio;
+    while (linha->num_campos < CSV_NUM_CAMPOS) {
+        const char* virgula = (const char*)memchr(p, ',', fim_linha - p);
+        const char* fim_campo = virgula ? virgula : fim_linha;
+        linha->campos[linha->num_campos].inicio = p;
+        linha->campos[linha->num_campos].tamanho = (size_t)(fim_campo - p);
+        linha->num_campos++;
+        if (!virgula) break;
+        p = virgula + 1;
+    }
+}
+
+// Entrega a proxima linha ja separada em campos. Retorna false no fim do
+// arquivo. Os campos saem direto da tabela de offsets montada por
+// csv_indexar; linhas vazias sao puladas e '\r' final e removido.
+static inline bool csv_proxima_linha(LeitorCSV* leitor, LinhaCSV* linha) {
+    TabelaCSV* tabela = &leitor->tabela;
+    while (tabela->proxima == tabela->quantidade) {
+        if (leitor->atual >= leitor->fim) return false;
+        if (csv_indexar(leitor) > 0) break;
+
+        // Nenhuma linha completa cabe na janela: trata a linha isoladamente
+        const char* inicio = leitor->atual;
+        const char* quebra = (const char*)memchr(inicio, '\n', leitor->fim - inicio);
+        const char* fim_linha = quebra ? quebra : leitor->fim;
+        leitor->atual = quebra ? quebra + 1 : leitor->fim;
+        if (fim_linha > inicio && fim_linha[-1] == '\r') fim_linha--;
+        if (fim_linha == inicio) continue;
+        csv_separar_linha(inicio, fim_linha, linha);
+        return true;
+    }
+
+    const OffsetsLinha* o = &tabela->linhas[tabela->proxima++];
+    const char* base = tabela->base;
+    linha->inicio = base + o->inicio_linha;
+    linha->tamanho = (size_t)(o->fim_linha - o->inicio_linha);
+    linha->num_campos = o->num_campos;
+    linha->amount_pronto = false;
+    for (int i = 0; i < o->num_campos; i++) {
+        uint16_t fim = i + 1 < o->num_campos ? o->inicio_campo[i + 1] - 1 : o->fim_ultimo;
+        linha->campos[i].inicio = base + o->inicio_campo[i];
+        linha->campos[i].tamanho = (size_t)(fim - o->inicio_campo[i]);
+    }
+    return true;
+}
+
+// Linha com as 10 colunas presentes e nenhuma vazia (mesmo criterio do sscanf antigo)
+static inline bool csv_linha_completa(const LinhaCSV* linha) {
+    if (linha->num_campos != CSV_NUM_CAMPOS) return false;
+    for (int i = 0; i < CSV_NUM_CAMPOS; i++)
+        if (linha->campos[i].tamanho == 0 && !(i == CAMPO_AMOUNT && linha->amount_pronto)) return false;
+    return true;
+}
+
+// ================= CONVERSAO DE CAMPOS =================
+
+// Copia o campo para um buffer de tamanho fixo, truncando se necessario
+static inline void csv_copiar_campo(char* destino, size_t capacidade, CampoCSV campo) {
+    size_t n = campo.tamanho < capacidade - 1 ? campo.tamanho : capacidade - 1;
+    memcpy(destino, campo.inicio, n);
+    destino[n] = '\0';
+}
+
+#define CSV_COPIAR(destino, campo) csv_copiar_campo((destino), sizeof(destino), (campo))
+
+static inline bool csv_campo_igual(CampoCSV campo, const char* texto) {
+    size_t n = strlen(texto);
+    return campo.tamanho == n && memcmp(campo.inicio, texto, n) == 0;
+}
+
+// Caminho generico (locale, expoente, espacos): copia e usa strtof
+static inline float csv_campo_float_strtof(CampoCSV campo) {
+    char buffer[64];
+    CSV_COPIAR(buffer, campo);
+    return strtof(buffer, NULL);
+}
+
+static const float CSV_POTENCIAS_F[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+static const double CSV_POTENCIAS_D[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Converte decimais simples ([+-]digitos[.digitos]) em ponto fixo: acumula a
+// mantissa inteira e divide uma unica vez pela potencia de 10. Quando mantissa
+// e divisor sao exatos em float a divisao ja sai com o arredondamento correto;
+// senao divide em double e so recorre ao strtof se o resultado cair exatamente
+// no meio de dois floats (duplo arredondamento). Qualquer outro formato vai
+// direto para o strtof, entao o valor e sempre identico ao caminho antigo.
+static inline float csv_campo_float(CampoCSV campo) {
+    const char* p = campo.inicio;
+    const char* fim = campo.inicio + campo.tamanho;
+    bool negativo = false;
+    if (p < fim && (*p == '-' || *p == '+')) {
+        negativo = *p == '-';
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int digitos = 0, casas = 0;
+    while (p < fim && (unsigned)(*p - '0') < 10) {
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        digitos++;
+        p++;
+    }
+    if (p < fim && *p == '.') {
+        p++;
+        while (p < fim && (unsigned)(*p - '0') < 10) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            digitos++;
+            casas++;
+            p++;
+        }
+    }
+    if (p != fim || digitos == 0 || digitos > 19 || casas > 22 || mantissa > (1ull << 53))
+        return csv_campo_float_strtof(campo);
+
+    float valor;
+    if (mantissa <= (1u << 24) && casas <= 10) {
+        valor = (float)mantissa / CSV_POTENCIAS_F[casas];
+    } else {
+        double exato = (double)mantissa / CSV_POTENCIAS_D[casas];
+        uint64_t bits;
+        memcpy(&bits, &exato, sizeof(bits));
+        if ((bits & 0x1FFFFFFFull) == 0x10000000ull)
+            return csv_campo_float_strtof(campo);
+        valor = (float)exato;
+    }
+    return negativo ? -valor : valor;
+}
+
+// Decodifica is_fraud sem desvios: uma leitura de 4 bytes comparada com "True".
+// Campos menores que 4 bytes leem de um buffer zerado para nao passar do fim
+// do mapeamento; o resultado equivale a strcmp(campo, "True") == 0.
+static inline bool csv_campo_fraude(CampoCSV campo) {
+    static const char zeros[4] = {0, 0, 0, 0};
+    const char* origem = campo.tamanho >= 4 ? campo.inicio : zeros;
+    uint32_t palavra, verdadeiro;
+    memcpy(&palavra, origem, 4);
+    memcpy(&verdadeiro, "True", 4);
+    return (palavra == verdadeiro) & (campo.tamanho == 4);
+}
+
+// Amount da linha: valor ja convertido quando vem do snapshot, senao o texto
+static inline float csv_linha_amount(const LinhaCSV* linha) {
+    return linha->amount_pronto ? linha->amount : csv_campo_float(linha->campos[CAMPO_AMOUNT]);
+}
+
+// ================= CARGA COMPLETA (SEQUENCIAL OU PARALELA) =================
+
+// Converte uma linha para o registro da estrutura; false descarta a linha
+typedef bool (*ConverterLinha)(const LinhaCSV* linha, void* registro);
+// Insere um registro ja convertido na estrutura de destino
+typedef void (*InserirRegistro)(void* registro, void* contexto);
+
+// Lote de registros convertidos a partir de um bloco do arquivo
+typedef struct BlocoCSV {
+    const char* inicio;
+    const char* fim;
+    char* registros;
+    size_t quantidade;
+    size_t capacidade;
+    bool pronto;
+} BlocoCSV;
+
+static inline void csv_avisar_linha_invalida(const LinhaCSV* linha) {
+    fprintf(stderr, "Linha ignorada por formato invalido: %.*s\n", (int)linha->tamanho, linha->inicio);
+}
+
+// Avanca p ate o inicio da linha seguinte (ou ate fim)
+static inline const char* csv_proxima_quebra(const char* p, const char* fim) {
+    if (p >= fim) return fim;
+    const char* quebra = (const char*)memchr(p, '\n', fim - p);
+    return quebra ? quebra + 1 : fim;
+}
+
+// Converte todas as linhas de um bloco para o lote do proprio bloco
+static inline void csv_converter_bloco(BlocoCSV* bloco, size_t tamanho_registro, ConverterLinha converter) {
+    LeitorCSV leitor;
+    LinhaCSV linha;
+    csv_intervalo(&leitor, bloco->inicio, bloco->fim);
+
+    bloco->quantidade = 0;
+    bloco->capacidade = (size_t)(bloco->fim - bloco->inicio) / 64 + 16;
+    bloco->registros = (char*)malloc(bloco->capacidade * tamanho_registro);
+    if (!bloco->registros) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        exit(1);
+    }
+
+    while (csv_proxima_linha(&leitor, &linha)) {
+        if (bloco->quantidade == bloco->capacidade) {
+            bloco->capacidade *= 2;
+            bloco->registros = (char*)realloc(bloco->registros, bloco->capacidade * tamanho_registro);
+            if (!bloco->registros) {
+                fprintf(stderr, "Erro de alocacao de memoria.\n");
+                exit(1);
+            }
+        }
+        char* destino = bloco->registros + bloco->quantidade * tamanho_registro;
+        if (converter(&linha, destino))
+            bloco->quantidade++;
+        else
+            csv_avisar_linha_invalida(&linha);
+    }
+}
+
+// Carrega o CSV inteiro na estrutura. Com varias threads, o arquivo e
+// dividido em blocos alinhados a quebras de linha; as threads convertem os
+// blocos em paralelo e a thread chamadora insere os lotes na ordem do
+// arquivo, pois as estruturas nao sao thread-safe. Retorna false se o
+// arquivo nao puder ser aberto.
+static inline bool csv_carregar(const char* caminho, size_t tamanho_registro,
+                                ConverterLinha converter, InserirRegistro inserir,
+                                void* contexto, int num_threads) {
+    LeitorCSV leitor;
+    if (!csv_abrir(&leitor, caminho)) return false;
+
+    if (num_threads == CSV_THREADS_AUTO)
+        num_threads = (int)std::thread::hardware_concurrency();
+    size_t tamanho = (size_t)(leitor.fim - leitor.atual);
+    if (num_threads < 1 || tamanho < CSV_TAMANHO_BLOCO)
+        num_threads = 1;
+
+    if (num_threads == 1) {
+        LinhaCSV linha;
+        char* registro = (char*)malloc(tamanho_registro);
+        if (!registro) {
+            fprintf(stderr, "Erro de alocacao de memoria.\n");
+            exit(1);
+        }
+        while (csv_proxima_linha(&leitor, &linha)) {
+            if (converter(&linha, registro))
+                inserir(registro, contexto);
+            else
+                csv_avisar_linha_invalida(&linha);
+        }
+        free(registro);
+        csv_fechar(&leitor);
+        return true;
+    }
+
+    // Divide o arquivo em blocos que terminam em quebra de linha
+    std::vector<BlocoCSV> blocos;
+    const char* p = leitor.atual;
+    while (p < leitor.fim) {
+        const char* corte = (size_t)(leitor.fim - p) > CSV_TAMANHO_BLOCO ? p + CSV_TAMANHO_BLOCO : leitor.fim;
+        corte = csv_proxima_quebra(corte - 1, leitor.fim);
+        BlocoCSV bloco = {p, corte, NULL, 0, 0, false};
+        blocos.push_back(bloco);
+        p = corte;
+    }
+
+    // As threads convertem no maximo "janela" blocos a frente da insercao,
+    // limitando a memoria ocupada pelos lotes
+    std::mutex trava;
+    std::condition_variable sinal;
+    size_t proximo = 0, inseridos = 0;
+    const size_t janela = 2 * (size_t)num_threads;
+
+    std::vector<std::thread> trabalhadores;
+    for (int i = 0; i < num_threads; i++) {
+        trabalhadores.emplace_back([&]() {
+            for (;;) {
+                size_t indice;
+                {
+                    std::unique_lock<std::mutex> lock(trava);
+                    sinal.wait(lock, [&]() { return proximo >= blocos.size() || proximo < inseridos + janela; });
+                    if (proximo >= blocos.size()) return;
+                    indice = proximo++;
+                }
+                csv_converter_bloco(&blocos[indice], tamanho_registro, converter);
+                {
+                    std::lock_guard<std::mutex> lock(trava);
+                    blocos[indice].pronto = true;
+                }
+                sinal.notify_all();
+            }
+        });
+    }
+
+    for (size_t i = 0; i < blocos.size(); i++) {
+        {
+            std::unique_lock<std::mutex> lock(trava);
+            sinal.wait(lock, [&]() { return blocos[i].pronto; });
+        }
+        for (size_t j = 0; j < blocos[i].quantidade; j++)
+            inserir(blocos[i].registros + j * tamanho_registro, contexto);
+        free(blocos[i].registros);
+        blocos[i].registros = NULL;
+        {
+            std::lock_guard<std::mutex> lock(trava);
+            inseridos++;
+        }
+        sinal.notify_all();
+    }
+
+    for (size_t i = 0; i < trabalhadores.size(); i++)
+        trabalhadores[i].join();
+    csv_fechar(&leitor);
+    return true;
+}
+
+#endif
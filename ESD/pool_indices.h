@@ -0,0 +1,103 @@
+// Pool de itens de tamanho fixo num vetor unico, enderecados por indices de
+// 32 bits. O indice 0 nunca e entregue e serve de "nulo", entao um filho
+// vazio de arvore e so 0. Itens devolvidos entram numa lista de livres
+// encadeada pelos primeiros 4 bytes do proprio item.
+//
+// O vetor comeca alinhado a 64 bytes e cresce dobrando; crescer move os
+// itens, entao entre alocacoes guarde indices, nunca ponteiros.
+#ifndef POOL_INDICES_H
+#define POOL_INDICES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define POOL_ALINHAMENTO 64        // Uma linha de cache
+#define POOL_CAPACIDADE_MINIMA 1024
+
+typedef struct PoolIndices {
+    void* bloco;                   // Retorno do malloc; "itens" e alinhado dentro dele
+    unsigned char* itens;
+    size_t tamanho_item;
+    uint32_t capacidade;
+    uint32_t usados;               // Proximo indice nunca entregue (comeca em 1)
+    uint32_t livre;                // Primeiro item devolvido (0 = lista vazia)
+    uint32_t vivos;
+} PoolIndices;
+
+static inline void pool_iniciar(PoolIndices* p, size_t tamanho_item) {
+    memset(p, 0, sizeof(*p));
+    p->tamanho_item = tamanho_item < sizeof(uint32_t) ? sizeof(uint32_t) : tamanho_item;
+    p->usados = 1;
+}
+
+static inline void* pool_item(const PoolIndices* p, uint32_t i) {
+    return p->itens + (size_t)i * p->tamanho_item;
+}
+
+// Garante espaco para "capacidade" itens (contando o 0) sem realocar depois
+static inline void pool_reservar(PoolIndices* p, uint32_t capacidade) {
+    if (capacidade <= p->capacidade) return;
+    void* bloco = malloc((size_t)capacidade * p->tamanho_item + POOL_ALINHAMENTO - 1);
+    if (!bloco) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        exit(1);
+    }
+    unsigned char* itens = (unsigned char*)(((uintptr_t)bloco + POOL_ALINHAMENTO - 1) & ~(uintptr_t)(POOL_ALINHAMENTO - 1));
+    if (p->itens) memcpy(itens, p->itens, (size_t)p->usados * p->tamanho_item);
+    free(p->bloco);
+    p->bloco = bloco;
+    p->itens = itens;
+    p->capacidade = capacidade;
+}
+
+// Indice de um item (conteudo indefinido): reaproveita um devolvido ou avanca
+static inline uint32_t pool_alocar(PoolIndices* p) {
+    uint32_t i;
+    if (p->livre) {
+        i = p->livre;
+        memcpy(&p->livre, pool_item(p, i), sizeof(uint32_t));
+    } else {
+        if (p->usados >= p->capacidade) {
+            if (p->capacidade >= UINT32_MAX / 2) {
+                fprintf(stderr, "Erro: limite de itens do pool atingido.\n");
+                exit(1);
+            }
+            pool_reservar(p, p->capacidade ? p->capacidade * 2 : POOL_CAPACIDADE_MINIMA);
+        }
+        i = p->usados++;
+    }
+    p->vivos++;
+    return i;
+}
+
+static inline void pool_devolver(PoolIndices* p, uint32_t i) {
+    memcpy(pool_item(p, i), &p->livre, sizeof(uint32_t));
+    p->livre = i;
+    p->vivos--;
+}
+
+// Copia "origem" para "destino", que deve estar vazio (recem iniciado ou
+// liberado); os indices continuam valendo na copia. Um memcpy so, O(n)
+static inline void pool_copiar(PoolIndices* destino, const PoolIndices* origem) {
+    pool_iniciar(destino, origem->tamanho_item);
+    if (origem->usados > 1) {
+        pool_reservar(destino, origem->usados);
+        memcpy(destino->itens, origem->itens, (size_t)origem->usados * origem->tamanho_item);
+    }
+    destino->usados = origem->usados;
+    destino->livre = origem->livre;
+    destino->vivos = origem->vivos;
+}
+
+static inline void pool_liberar(PoolIndices* p) {
+    free(p->bloco);
+    pool_iniciar(p, p->tamanho_item);
+}
+
+static inline size_t pool_memoria(const PoolIndices* p) {
+    return (size_t)p->capacidade * p->tamanho_item;
+}
+
+#endif
@@ -0,0 +1,497 @@
+// Snapshot binario colunar (.fdb) do dataset de transacoes.
+// Na primeira execucao o CSV e convertido para um arquivo ao lado dele
+// (mesmo nome, extensao .fdb); nas seguintes o snapshot e mapeado em memoria
+// e as linhas sao entregues aos mesmos callbacks de conversao/insercao do
+// leitor_csv.h, sem nenhum parsing de texto.
+//
+// Layout (little-endian, tudo em tamanho fixo):
+//   CabecalhoFDB
+//   grupos de ate FDB_LINHAS_GRUPO linhas, cada um coluna a coluna:
+//     id[16] | timestamp[32] | sender[32] | receiver[32] | amount (float) |
+//     tipo, categoria, local, dispositivo (uint16, codigo no dicionario) |
+//     is_fraud (1 bit por linha)
+//   dicionarios: para cada coluna categorica, uint32 quantidade + valores[32]
+// Textos menores que a largura sao completados com '\0'.
+//
+// Se o CSV nao couber nesse formato (campo mais largo que a coluna, dicionario
+// cheio), o .fdb vira so um cabecalho com a magica "FDBN" e o tamanho/data do
+// CSV: as execucoes seguintes vao direto ao CSV sem tentar gravar de novo,
+// ate o CSV mudar.
+#ifndef SNAPSHOT_FDB_H
+#define SNAPSHOT_FDB_H
+
+#include "leitor_csv.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#define FDB_VERSAO 1
+#define FDB_LINHAS_GRUPO 65536u  // Linhas por grupo (multiplo de 64)
+#define FDB_MAX_CATEGORIAS 65535u
+#define FDB_LARGURA_CATEGORIA 32
+#define FDB_NUM_TEXTOS 4
+#define FDB_NUM_CATEGORICAS 4
+#define FDB_CAPACIDADE_HASH (1u << 17) // Slots do hash de cada dicionario (> 2 * FDB_MAX_CATEGORIAS)
+
+// Colunas de texto de largura fixa e suas larguras
+static const int FDB_CAMPOS_TEXTO[FDB_NUM_TEXTOS] = {CAMPO_ID, CAMPO_TIMESTAMP, CAMPO_SENDER, CAMPO_RECEIVER};
+static const size_t FDB_LARGURAS_TEXTO[FDB_NUM_TEXTOS] = {16, 32, 32, 32};
+// Colunas com poucos valores distintos, guardadas como codigos de dicionario
+static const int FDB_CAMPOS_CATEGORICOS[FDB_NUM_CATEGORICAS] = {CAMPO_TIPO, CAMPO_CATEGORIA, CAMPO_LOCAL, CAMPO_DISPOSITIVO};
+
+// ================= ESTRUTURAS =================
+
+typedef struct CabecalhoFDB {
+    char magica[4];             // "FDB1"
+    uint32_t versao;
+    uint64_t tamanho_csv;       // Tamanho e data do CSV de origem, para
+    int64_t modificacao_csv;    // descartar o snapshot quando o CSV mudar
+    uint64_t num_linhas;
+    uint32_t linhas_por_grupo;
+    uint32_t num_categoricas;
+    uint64_t offset_dicionarios;
+} CabecalhoFDB;
+
+// Dicionario de uma coluna categorica usado na gravacao
+typedef struct DicionarioFDB {
+    char (*valores)[FDB_LARGURA_CATEGORIA];
+    uint32_t quantidade;
+    uint32_t capacidade;
+    int32_t* slots; // Indices em "valores" (-1 = vazio), enderecamento aberto
+} DicionarioFDB;
+
+// Buffers de um grupo de linhas durante a gravacao
+typedef struct GrupoFDB {
+    char* textos[FDB_NUM_TEXTOS];
+    float* amount;
+    uint16_t* codigos[FDB_NUM_CATEGORICAS];
+    uint8_t* fraude;
+    uint32_t quantidade;
+} GrupoFDB;
+
+// ================= FUNCOES AUXILIARES =================
+
+// Troca a extensao .csv por "extensao" (ou a acrescenta), para arquivos
+// derivados do dataset como o snapshot e filtros serializados
+static inline bool fdb_caminho_derivado(const char* caminho_csv, const char* extensao, char* destino, size_t capacidade) {
+    size_t n = strlen(caminho_csv), e = strlen(extensao);
+    if (n >= 4 && (strcmp(caminho_csv + n - 4, ".csv") == 0 || strcmp(caminho_csv + n - 4, ".CSV") == 0))
+        n -= 4;
+    if (n + e + 1 > capacidade) return false;
+    memcpy(destino, caminho_csv, n);
+    memcpy(destino + n, extensao, e + 1);
+    return true;
+}
+
+static inline bool fdb_caminho_snapshot(const char* caminho_csv, char* destino, size_t capacidade) {
+    return fdb_caminho_derivado(caminho_csv, ".fdb", destino, capacidade);
+}
+
+static inline bool fdb_info_csv(const char* caminho_csv, uint64_t* tamanho, int64_t* modificacao) {
+    struct stat info;
+    if (stat(caminho_csv, &info) != 0) return false;
+    *tamanho = (uint64_t)info.st_size;
+    *modificacao = (int64_t)info.st_mtime;
+    return true;
+}
+
+// Bytes ocupados por um grupo com "linhas" linhas
+static inline uint64_t fdb_tamanho_grupo(uint64_t linhas) {
+    uint64_t por_linha = sizeof(float) + FDB_NUM_CATEGORICAS * sizeof(uint16_t);
+    for (int k = 0; k < FDB_NUM_TEXTOS; k++) por_linha += FDB_LARGURAS_TEXTO[k];
+    return linhas * por_linha + (linhas + 7) / 8;
+}
+
+static inline uint32_t fdb_hash_texto(const char* p, size_t n) {
+    uint32_t h = 2166136261u; // FNV-1a
+    for (size_t i = 0; i < n; i++) {
+        h ^= (unsigned char)p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static inline void fdb_dicionario_iniciar(DicionarioFDB* d) {
+    d->quantidade = 0;
+    d->capacidade = 64;
+    d->valores = (char (*)[FDB_LARGURA_CATEGORIA])malloc(d->capacidade * FDB_LARGURA_CATEGORIA);
+    d->slots = (int32_t*)malloc(FDB_CAPACIDADE_HASH * sizeof(int32_t));
+    if (!d->valores || !d->slots) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        exit(1);
+    }
+    memset(d->slots, 0xFF, FDB_CAPACIDADE_HASH * sizeof(int32_t));
+}
+
+static inline void fdb_dicionario_liberar(DicionarioFDB* d) {
+    free(d->valores);
+    free(d->slots);
+    d->valores = NULL;
+    d->slots = NULL;
+}
+
+// Devolve o codigo do valor, inserindo-o se for novo. -1 se o valor nao
+// couber na largura fixa ou se o dicionario estiver cheio.
+static inline int32_t fdb_dicionario_codigo(DicionarioFDB* d, CampoCSV campo) {
+    if (campo.tamanho > FDB_LARGURA_CATEGORIA) return -1;
+    uint32_t slot = fdb_hash_texto(campo.inicio, campo.tamanho) & (FDB_CAPACIDADE_HASH - 1);
+    for (;;) {
+        int32_t indice = d->slots[slot];
+        if (indice < 0) break;
+        const char* valor = d->valores[indice];
+        if (memcmp(valor, campo.inicio, campo.tamanho) == 0 &&
+            (campo.tamanho == FDB_LARGURA_CATEGORIA || valor[campo.tamanho] == '\0'))
+            return indice;
+        slot = (slot + 1) & (FDB_CAPACIDADE_HASH - 1);
+    }
+
+    if (d->quantidade == FDB_MAX_CATEGORIAS) return -1;
+    if (d->quantidade == d->capacidade) {
+        d->capacidade *= 2;
+        d->valores = (char (*)[FDB_LARGURA_CATEGORIA])realloc(d->valores, d->capacidade * FDB_LARGURA_CATEGORIA);
+        if (!d->valores) {
+            fprintf(stderr, "Erro de alocacao de memoria.\n");
+            exit(1);
+        }
+    }
+    memset(d->valores[d->quantidade], 0, FDB_LARGURA_CATEGORIA);
+    memcpy(d->valores[d->quantidade], campo.inicio, campo.tamanho);
+    d->slots[slot] = (int32_t)d->quantidade;
+    return (int32_t)d->quantidade++;
+}
+
+// ================= GRAVACAO =================
+
+// Marca que o CSV descrito em "cab" nao cabe no formato fixo. So o cabecalho
+// vai para o disco; um marcador truncado falha na magica e so faz a proxima
+// execucao tentar de novo
+static inline void fdb_gravar_recusa(const char* caminho_fdb, const CabecalhoFDB* cab) {
+    CabecalhoFDB marcador = *cab;
+    memcpy(marcador.magica, "FDBN", 4);
+    marcador.num_linhas = 0;
+    marcador.offset_dicionarios = 0;
+    FILE* f = fopen(caminho_fdb, "wb");
+    if (!f) return;
+    bool ok = fwrite(&marcador, sizeof(marcador), 1, f) == 1;
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) remove(caminho_fdb);
+}
+
+// true se "caminho_fdb" e um marcador de recusa ainda valido para o CSV
+static inline bool fdb_recusado(const char* caminho_fdb, const char* caminho_csv) {
+    FILE* f = fopen(caminho_fdb, "rb");
+    if (!f) return false;
+    CabecalhoFDB cab;
+    bool ok = fread(&cab, sizeof(cab), 1, f) == 1 && memcmp(cab.magica, "FDBN", 4) == 0 &&
+              cab.versao == FDB_VERSAO;
+    fclose(f);
+    uint64_t tamanho_csv;
+    int64_t modificacao_csv;
+    return ok && fdb_info_csv(caminho_csv, &tamanho_csv, &modificacao_csv) &&
+           tamanho_csv == cab.tamanho_csv && modificacao_csv == cab.modificacao_csv;
+}
+
+static inline bool fdb_gravar_grupo(FILE* f, const GrupoFDB* g) {
+    size_t n = g->quantidade;
+    bool ok = true;
+    for (int k = 0; k < FDB_NUM_TEXTOS; k++)
+        ok = ok && fwrite(g->textos[k], FDB_LARGURAS_TEXTO[k], n, f) == n;
+    ok = ok && fwrite(g->amount, sizeof(float), n, f) == n;
+    for (int k = 0; k < FDB_NUM_CATEGORICAS; k++)
+        ok = ok && fwrite(g->codigos[k], sizeof(uint16_t), n, f) == n;
+    ok = ok && fwrite(g->fraude, 1, (n + 7) / 8, f) == (n + 7) / 8;
+    return ok;
+}
+
+// Converte o CSV em snapshot. Grava num arquivo temporario e so renomeia no
+// fim, para nunca deixar um .fdb incompleto. Linhas que o leitor considera
+// invalidas (csv_linha_completa) nao entram no snapshot. Se uma linha valida
+// nao couber no formato fixo, deixa o marcador de recusa no lugar do .fdb.
+static inline bool fdb_gravar(const char* caminho_csv, const char* caminho_fdb) {
+    CabecalhoFDB cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, "FDB1", 4);
+    cab.versao = FDB_VERSAO;
+    cab.linhas_por_grupo = FDB_LINHAS_GRUPO;
+    cab.num_categoricas = FDB_NUM_CATEGORICAS;
+    if (!fdb_info_csv(caminho_csv, &cab.tamanho_csv, &cab.modificacao_csv)) return false;
+
+    LeitorCSV leitor;
+    if (!csv_abrir(&leitor, caminho_csv)) return false;
+
+    char temporario[1024];
+    if (strlen(caminho_fdb) + 5 > sizeof(temporario)) {
+        csv_fechar(&leitor);
+        return false;
+    }
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho_fdb);
+    FILE* f = fopen(temporario, "wb");
+    if (!f) {
+        csv_fechar(&leitor);
+        return false;
+    }
+
+    GrupoFDB grupo;
+    for (int k = 0; k < FDB_NUM_TEXTOS; k++)
+        grupo.textos[k] = (char*)malloc(FDB_LINHAS_GRUPO * FDB_LARGURAS_TEXTO[k]);
+    grupo.amount = (float*)malloc(FDB_LINHAS_GRUPO * sizeof(float));
+    for (int k = 0; k < FDB_NUM_CATEGORICAS; k++)
+        grupo.codigos[k] = (uint16_t*)malloc(FDB_LINHAS_GRUPO * sizeof(uint16_t));
+    grupo.fraude = (uint8_t*)calloc(FDB_LINHAS_GRUPO / 8, 1);
+    bool alocado = grupo.amount && grupo.fraude;
+    for (int k = 0; k < FDB_NUM_TEXTOS; k++) alocado = alocado && grupo.textos[k];
+    for (int k = 0; k < FDB_NUM_CATEGORICAS; k++) alocado = alocado && grupo.codigos[k];
+    if (!alocado) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        exit(1);
+    }
+    grupo.quantidade = 0;
+    DicionarioFDB dicionarios[FDB_NUM_CATEGORICAS];
+    for (int k = 0; k < FDB_NUM_CATEGORICAS; k++)
+        fdb_dicionario_iniciar(&dicionarios[k]);
+
+    bool ok = fwrite(&cab, sizeof(cab), 1, f) == 1;
+    bool fora_do_formato = false;
+    LinhaCSV linha;
+    while (ok && csv_proxima_linha(&leitor, &linha)) {
+        if (!csv_linha_completa(&linha)) continue;
+
+        uint32_t i = grupo.quantidade;
+        for (int k = 0; k < FDB_NUM_TEXTOS && ok; k++) {
+            CampoCSV campo = linha.campos[FDB_CAMPOS_TEXTO[k]];
+            char* destino = grupo.textos[k] + (size_t)i * FDB_LARGURAS_TEXTO[k];
+            ok = campo.tamanho <= FDB_LARGURAS_TEXTO[k];
+            if (!ok) break;
+            memcpy(destino, campo.inicio, campo.tamanho);
+            memset(destino + campo.tamanho, 0, FDB_LARGURAS_TEXTO[k] - campo.tamanho);
+        }
+        for (int k = 0; k < FDB_NUM_CATEGORICAS && ok; k++) {
+            int32_t codigo = fdb_dicionario_codigo(&dicionarios[k], linha.campos[FDB_CAMPOS_CATEGORICOS[k]]);
+            ok = codigo >= 0;
+            grupo.codigos[k][i] = (uint16_t)codigo;
+        }
+        if (!ok) { // Campo fora do formato fixo: fica so o CSV
+            fora_do_formato = true;
+            break;
+        }
+
+        grupo.amount[i] = csv_campo_float(linha.campos[CAMPO_AMOUNT]);
+        grupo.fraude[i >> 3] |= (uint8_t)(csv_campo_fraude(linha.campos[CAMPO_FRAUDE]) << (i & 7));
+        grupo.quantidade++;
+        cab.num_linhas++;
+
+        if (grupo.quantidade == FDB_LINHAS_GRUPO) {
+            ok = fdb_gravar_grupo(f, &grupo);
+            grupo.quantidade = 0;
+            memset(grupo.fraude, 0, FDB_LINHAS_GRUPO / 8);
+        }
+    }
+    if (ok && grupo.quantidade > 0)
+        ok = fdb_gravar_grupo(f, &grupo);
+
+    cab.offset_dicionarios = sizeof(CabecalhoFDB) +
+        (cab.num_linhas / FDB_LINHAS_GRUPO) * fdb_tamanho_grupo(FDB_LINHAS_GRUPO) +
+        fdb_tamanho_grupo(cab.num_linhas % FDB_LINHAS_GRUPO);
+    for (int k = 0; k < FDB_NUM_CATEGORICAS && ok; k++) {
+        ok = fwrite(&dicionarios[k].quantidade, sizeof(uint32_t), 1, f) == 1 &&
+             fwrite(dicionarios[k].valores, FDB_LARGURA_CATEGORIA, dicionarios[k].quantidade, f) == dicionarios[k].quantidade;
+    }
+    if (ok) ok = fseek(f, 0, SEEK_SET) == 0 && fwrite(&cab, sizeof(cab), 1, f) == 1;
+    ok = (fclose(f) == 0) && ok;
+
+    for (int k = 0; k < FDB_NUM_TEXTOS; k++) free(grupo.textos[k]);
+    free(grupo.amount);
+    for (int k = 0; k < FDB_NUM_CATEGORICAS; k++) {
+        free(grupo.codigos[k]);
+        fdb_dicionario_liberar(&dicionarios[k]);
+    }
+    free(grupo.fraude);
+    csv_fechar(&leitor);
+
+    if (ok) {
+        remove(caminho_fdb); // rename nao sobrescreve no Windows
+        ok = rename(temporario, caminho_fdb) == 0;
+    }
+    if (!ok) remove(temporario);
+    if (fora_do_formato) fdb_gravar_recusa(caminho_fdb, &cab);
+    return ok;
+}
+
+// ================= LEITURA =================
+
+// Carrega o snapshot na estrutura chamando converter/inserir para cada linha.
+// Retorna false, sem inserir nada, se o arquivo nao existir, estiver
+// corrompido ou for mais antigo que o CSV de origem.
+static inline bool fdb_carregar(const char* caminho_fdb, const char* caminho_csv, size_t tamanho_registro,
+                                ConverterLinha converter, InserirRegistro inserir, void* contexto) {
+    ArquivoMapeado arquivo;
+    if (!mapear_arquivo(&arquivo, caminho_fdb)) return false;
+
+    CabecalhoFDB cab;
+    bool ok = arquivo.tamanho >= sizeof(cab);
+    if (ok) {
+        memcpy(&cab, arquivo.dados, sizeof(cab));
+        ok = memcmp(cab.magica, "FDB1", 4) == 0 && cab.versao == FDB_VERSAO &&
+             cab.linhas_por_grupo == FDB_LINHAS_GRUPO && cab.num_categoricas == FDB_NUM_CATEGORICAS;
+    }
+
+    // Sem o CSV o snapshot vale sozinho; com ele, precisa estar atualizado
+    uint64_t tamanho_csv;
+    int64_t modificacao_csv;
+    if (ok && fdb_info_csv(caminho_csv, &tamanho_csv, &modificacao_csv))
+        ok = tamanho_csv == cab.tamanho_csv && modificacao_csv == cab.modificacao_csv;
+
+    uint64_t grupos_completos = ok ? cab.num_linhas / FDB_LINHAS_GRUPO : 0;
+    uint64_t tamanho_grupo = fdb_tamanho_grupo(FDB_LINHAS_GRUPO);
+    ok = ok && cab.offset_dicionarios == sizeof(CabecalhoFDB) + grupos_completos * tamanho_grupo +
+                                         fdb_tamanho_grupo(cab.num_linhas % FDB_LINHAS_GRUPO);
+
+    // Valores de cada dicionario ja como visoes prontas para a LinhaCSV
+    CampoCSV* valores[FDB_NUM_CATEGORICAS] = {NULL};
+    uint32_t quantidades[FDB_NUM_CATEGORICAS] = {0};
+    uint64_t posicao = ok ? cab.offset_dicionarios : 0;
+    for (int k = 0; k < FDB_NUM_CATEGORICAS && ok; k++) {
+        ok = posicao + sizeof(uint32_t) <= arquivo.tamanho;
+        if (!ok) break;
+        memcpy(&quantidades[k], arquivo.dados + posicao, sizeof(uint32_t));
+        posicao += sizeof(uint32_t);
+        ok = quantidades[k] <= FDB_MAX_CATEGORIAS &&
+             posicao + (uint64_t)quantidades[k] * FDB_LARGURA_CATEGORIA <= arquivo.tamanho;
+        if (!ok) break;
+        valores[k] = (CampoCSV*)malloc((quantidades[k] + 1) * sizeof(CampoCSV));
+        if (!valores[k]) {
+            fprintf(stderr, "Erro de alocacao de memoria.\n");
+            exit(1);
+        }
+        for (uint32_t v = 0; v < quantidades[k]; v++) {
+            const char* p = arquivo.dados + posicao + (uint64_t)v * FDB_LARGURA_CATEGORIA;
+            const char* zero = (const char*)memchr(p, '\0', FDB_LARGURA_CATEGORIA);
+            valores[k][v].inicio = p;
+            valores[k][v].tamanho = zero ? (size_t)(zero - p) : FDB_LARGURA_CATEGORIA;
+        }
+        posicao += (uint64_t)quantidades[k] * FDB_LARGURA_CATEGORIA;
+    }
+    ok = ok && posicao == arquivo.tamanho;
+
+    // Confere os codigos antes de inserir qualquer linha
+    for (uint64_t g = 0; ok && g * FDB_LINHAS_GRUPO < cab.num_linhas; g++) {
+        uint64_t n = cab.num_linhas - g * FDB_LINHAS_GRUPO;
+        if (n > FDB_LINHAS_GRUPO) n = FDB_LINHAS_GRUPO;
+        const char* p = arquivo.dados + sizeof(CabecalhoFDB) + g * tamanho_grupo +
+                        (fdb_tamanho_grupo(n) - (n + 7) / 8) - n * FDB_NUM_CATEGORICAS * sizeof(uint16_t);
+        for (int k = 0; k < FDB_NUM_CATEGORICAS && ok; k++) {
+            for (uint64_t i = 0; i < n; i++) {
+                uint16_t codigo;
+                memcpy(&codigo, p + (k * n + i) * sizeof(uint16_t), sizeof(uint16_t));
+                if (codigo >= quantidades[k]) {
+                    ok = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (ok) {
+        char* registro = (char*)malloc(tamanho_registro);
+        if (!registro) {
+            fprintf(stderr, "Erro de alocacao de memoria.\n");
+            exit(1);
+        }
+        static const char verdadeiro[] = "True";
+        static const char falso[] = "False";
+        LinhaCSV linha;
+        memset(&linha, 0, sizeof(linha));
+        linha.num_campos = CSV_NUM_CAMPOS;
+        linha.amount_pronto = true;
+
+        for (uint64_t g = 0; g * FDB_LINHAS_GRUPO < cab.num_linhas; g++) {
+            uint64_t n = cab.num_linhas - g * FDB_LINHAS_GRUPO;
+            if (n > FDB_LINHAS_GRUPO) n = FDB_LINHAS_GRUPO;
+
+            const char* p = arquivo.dados + sizeof(CabecalhoFDB) + g * tamanho_grupo;
+            const char* textos[FDB_NUM_TEXTOS];
+            for (int k = 0; k < FDB_NUM_TEXTOS; k++) {
+                textos[k] = p;
+                p += n * FDB_LARGURAS_TEXTO[k];
+            }
+            const char* amounts = p;
+            p += n * sizeof(float);
+            const char* codigos = p;
+            p += n * FDB_NUM_CATEGORICAS * sizeof(uint16_t);
+            const uint8_t* fraude = (const uint8_t*)p;
+
+            for (uint64_t i = 0; i < n; i++) {
+                for (int k = 0; k < FDB_NUM_TEXTOS; k++) {
+                    const char* texto = textos[k] + i * FDB_LARGURAS_TEXTO[k];
+                    const char* zero = (const char*)memchr(texto, '\0', FDB_LARGURAS_TEXTO[k]);
+                    linha.campos[FDB_CAMPOS_TEXTO[k]].inicio = texto;
+                    linha.campos[FDB_CAMPOS_TEXTO[k]].tamanho = zero ? (size_t)(zero - texto) : FDB_LARGURAS_TEXTO[k];
+                }
+                for (int k = 0; k < FDB_NUM_CATEGORICAS; k++) {
+                    uint16_t codigo;
+                    memcpy(&codigo, codigos + (k * n + i) * sizeof(uint16_t), sizeof(uint16_t));
+                    linha.campos[FDB_CAMPOS_CATEGORICOS[k]] = valores[k][codigo];
+                }
+                memcpy(&linha.amount, amounts + i * sizeof(float), sizeof(float));
+                bool fraudulenta = (fraude[i >> 3] >> (i & 7)) & 1;
+                linha.campos[CAMPO_FRAUDE].inicio = fraudulenta ? verdadeiro : falso;
+                linha.campos[CAMPO_FRAUDE].tamanho = fraudulenta ? 4 : 5;
+                linha.inicio = linha.campos[CAMPO_ID].inicio;
+                linha.tamanho = linha.campos[CAMPO_ID].tamanho;
+
+                if (converter(&linha, registro))
+                    inserir(registro, contexto);
+                else
+                    csv_avisar_linha_invalida(&linha);
+            }
+        }
+        free(registro);
+    }
+
+    for (int k = 0; k < FDB_NUM_CATEGORICAS; k++) free(valores[k]);
+    desmapear_arquivo(&arquivo);
+    return ok;
+}
+
+// Linhas que a carga vai produzir: exato pelo cabecalho de um snapshot em dia,
+// senao a estimativa do CSV. Serve para dimensionar os indices de antemao.
+static inline size_t fdb_estimar_linhas(const char* caminho_csv) {
+    char caminho_fdb[1024];
+    uint64_t tamanho_csv;
+    int64_t modificacao_csv;
+    if (fdb_caminho_snapshot(caminho_csv, caminho_fdb, sizeof(caminho_fdb))) {
+        FILE* f = fopen(caminho_fdb, "rb");
+        if (f) {
+            CabecalhoFDB cab;
+            bool ok = fread(&cab, sizeof(cab), 1, f) == 1 && memcmp(cab.magica, "FDB1", 4) == 0 &&
+                      cab.versao == FDB_VERSAO;
+            fclose(f);
+            if (ok && (!fdb_info_csv(caminho_csv, &tamanho_csv, &modificacao_csv) ||
+                       (tamanho_csv == cab.tamanho_csv && modificacao_csv == cab.modificacao_csv)))
+                return (size_t)cab.num_linhas;
+        }
+    }
+    return csv_estimar_linhas(caminho_csv);
+}
+
+// Ponto de entrada dos programas: usa o snapshot se estiver valido, senao
+// gera um novo a partir do CSV e carrega dele. Se o snapshot nao puder ser
+// gravado (pasta somente leitura, campo maior que a largura fixa), cai para
+// a carga direta do CSV; no segundo caso o marcador de recusa evita repetir
+// a tentativa a cada execucao. Retorna false se nem o CSV puder ser aberto.
+static inline bool fdb_carregar_ou_gerar(const char* caminho_csv, size_t tamanho_registro,
+                                         ConverterLinha converter, InserirRegistro inserir,
+                                         void* contexto, int num_threads) {
+    char caminho_fdb[1024];
+    if (fdb_caminho_snapshot(caminho_csv, caminho_fdb, sizeof(caminho_fdb))) {
+        if (fdb_carregar(caminho_fdb, caminho_csv, tamanho_registro, converter, inserir, contexto))
+            return true;
+        if (!fdb_recusado(caminho_fdb, caminho_csv) && fdb_gravar(caminho_csv, caminho_fdb)) {
+            printf("Snapshot binario gerado: %s\n", caminho_fdb);
+            if (fdb_carregar(caminho_fdb, caminho_csv, tamanho_registro, converter, inserir, contexto))
+                return true;
+        }
+    }
+    return csv_carregar(caminho_csv, tamanho_registro, converter, inserir, contexto, num_threads);
+}
+
+#endif
@@ -0,0 +1,262 @@
+// Tabela hash de enderecamento aberto no estilo "Swiss table".
+// Cada slot tem 1 byte de controle (vazio, apagado ou os 7 bits baixos do
+// hash da chave); a busca compara 16 bytes de controle de uma vez com SSE2 e
+// so olha a chave dos slots cujo byte bate. Os slots guardam apenas o indice
+// do registro: os registros ficam num array denso separado, sem um malloc por
+// insercao e sem ponteiro a seguir em cada colisao.
+//
+// A chave e uma string terminada em '\0' dentro do proprio registro (por
+// exemplo transaction_id), informada pelo deslocamento no struct. Ponteiros
+// devolvidos pela tabela valem ate a proxima insercao ou remocao.
+#ifndef TABELA_SWISS_H
+#define TABELA_SWISS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "hash_rapido.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SWISS_SSE2 1
+#else
+#define SWISS_SSE2 0
+#endif
+
+#define SWISS_GRUPO 16               // Slots comparados por instrucao
+#define SWISS_VAZIO ((int8_t)-128)   // 0x80
+#define SWISS_APAGADO ((int8_t)-2)   // 0xFE
+#define SWISS_CAPACIDADE_MINIMA 16
+
+// ================= ESTRUTURAS =================
+
+typedef struct TabelaSwiss {
+    int8_t* controle;           // 1 byte por slot
+    uint32_t* indices;          // Slot -> posicao do registro no array denso
+    char* registros;            // Registros contiguos, na ordem de insercao
+    uint32_t* slot_do_registro; // Registro -> slot, para remover sem buscar de novo
+    size_t tamanho_registro;
+    size_t deslocamento_chave;  // offsetof da chave dentro do registro
+    size_t capacidade;          // Slots (potencia de 2, multiplo de SWISS_GRUPO)
+    size_t quantidade;
+    size_t apagados;            // Slots com SWISS_APAGADO, contam para a carga
+    size_t capacidade_registros;
+} TabelaSwiss;
+
+// ================= FUNCOES AUXILIARES =================
+
+static inline uint64_t swiss_hash(const char* chave) {
+    return hash_texto(chave);
+}
+
+// Bits i das mascaras indicam os slots do grupo cujo controle e igual a "valor"
+static inline uint32_t swiss_casar(const int8_t* grupo, int8_t valor) {
+#if SWISS_SSE2
+    __m128i bytes = _mm_load_si128((const __m128i*)grupo);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(valor)));
+#else
+    uint32_t mascara = 0;
+    for (int i = 0; i < SWISS_GRUPO; i++)
+        mascara |= (uint32_t)(grupo[i] == valor) << i;
+    return mascara;
+#endif
+}
+
+// Vazios ou apagados: os dois tem o bit mais alto ligado
+static inline uint32_t swiss_livres(const int8_t* grupo) {
+#if SWISS_SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_load_si128((const __m128i*)grupo));
+#else
+    uint32_t mascara = 0;
+    for (int i = 0; i < SWISS_GRUPO; i++)
+        mascara |= (uint32_t)(grupo[i] < 0) << i;
+    return mascara;
+#endif
+}
+
+static inline int swiss_primeiro_bit(uint32_t mascara) {
+#if defined(_MSC_VER)
+    unsigned long indice;
+    _BitScanForward(&indice, mascara);
+    return (int)indice;
+#else
+    return __builtin_ctz(mascara);
+#endif
+}
+
+static inline const char* swiss_chave(const TabelaSwiss* t, size_t registro) {
+    return t->registros + registro * t->tamanho_registro + t->deslocamento_chave;
+}
+
+static inline void* swiss_alocar(size_t bytes) {
+    void* p = malloc(bytes);
+    if (!p) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        exit(1);
+    }
+    return p;
+}
+
+// Controle alinhado a 16 bytes para as leituras com _mm_load_si128
+static inline int8_t* swiss_alocar_controle(size_t capacidade) {
+    char* bruto = (char*)swiss_alocar(capacidade + SWISS_GRUPO + sizeof(void*));
+    uintptr_t alinhado = ((uintptr_t)bruto + sizeof(void*) + SWISS_GRUPO - 1) & ~(uintptr_t)(SWISS_GRUPO - 1);
+    ((char**)alinhado)[-1] = bruto;
+    memset((void*)alinhado, (unsigned char)SWISS_VAZIO, capacidade);
+    return (int8_t*)alinhado;
+}
+
+static inline void swiss_liberar_controle(int8_t* controle) {
+    if (controle) free(((char**)controle)[-1]);
+}
+
+// Slot livre para uma chave que sabidamente nao esta na tabela
+static inline size_t swiss_slot_livre(const TabelaSwiss* t, uint64_t h) {
+    size_t mascara_grupos = t->capacidade / SWISS_GRUPO - 1;
+    size_t grupo = (size_t)(h >> 7) & mascara_grupos;
+    for (size_t passo = 1;; passo++) {
+        uint32_t livres = swiss_livres(t->controle + grupo * SWISS_GRUPO);
+        if (livres) return grupo * SWISS_GRUPO + swiss_primeiro_bit(livres);
+        grupo = (grupo + passo) & mascara_grupos; // Sondagem triangular entre grupos
+    }
+}
+
+// Refaz o controle com "capacidade" slots a partir do array denso
+static inline void swiss_reconstruir(TabelaSwiss* t, size_t capacidade) {
+    swiss_liberar_controle(t->controle);
+    free(t->indices);
+    t->capacidade = capacidade;
+    t->controle = swiss_alocar_controle(capacidade);
+    t->indices = (uint32_t*)swiss_alocar(capacidade * sizeof(uint32_t));
+    t->apagados = 0;
+    for (size_t r = 0; r < t->quantidade; r++) {
+        uint64_t h = swiss_hash(swiss_chave(t, r));
+        size_t slot = swiss_slot_livre(t, h);
+        t->controle[slot] = (int8_t)(h & 0x7F);
+        t->indices[slot] = (uint32_t)r;
+        t->slot_do_registro[r] = (uint32_t)slot;
+    }
+}
+
+// Slot onde a chave (com hash h) esta, ou -1
+static inline long long swiss_localizar(const TabelaSwiss* t, const char* chave, uint64_t h) {
+    int8_t etiqueta = (int8_t)(h & 0x7F);
+    size_t mascara_grupos = t->capacidade / SWISS_GRUPO - 1;
+    size_t grupo = (size_t)(h >> 7) & mascara_grupos;
+
+    for (size_t passo = 1; passo <= mascara_grupos + 1; passo++) {
+        const int8_t* controle = t->controle + grupo * SWISS_GRUPO;
+        uint32_t candidatos = swiss_casar(controle, etiqueta);
+        while (candidatos) {
+            size_t slot = grupo * SWISS_GRUPO + swiss_primeiro_bit(candidatos);
+            if (strcmp(swiss_chave(t, t->indices[slot]), chave) == 0)
+                return (long long)slot;
+            candidatos &= candidatos - 1;
+        }
+        if (swiss_casar(controle, SWISS_VAZIO)) return -1; // Grupo com vazio encerra a sondagem
+        grupo = (grupo + passo) & mascara_grupos;
+    }
+    return -1;
+}
+
+// ================= OPERACOES =================
+
+static inline void swiss_iniciar(TabelaSwiss* t, size_t tamanho_registro, size_t deslocamento_chave) {
+    memset(t, 0, sizeof(*t));
+    t->tamanho_registro = tamanho_registro;
+    t->deslocamento_chave = deslocamento_chave;
+    t->capacidade_registros = SWISS_CAPACIDADE_MINIMA;
+    t->registros = (char*)swiss_alocar(t->capacidade_registros * tamanho_registro);
+    t->slot_do_registro = (uint32_t*)swiss_alocar(t->capacidade_registros * sizeof(uint32_t));
+    swiss_reconstruir(t, SWISS_CAPACIDADE_MINIMA);
+}
+
+static inline void swiss_liberar(TabelaSwiss* t) {
+    swiss_liberar_controle(t->controle);
+    free(t->indices);
+    free(t->registros);
+    free(t->slot_do_registro);
+    memset(t, 0, sizeof(*t));
+}
+
+static inline void* swiss_buscar(const TabelaSwiss* t, const char* chave) {
+    long long slot = swiss_localizar(t, chave, swiss_hash(chave));
+    return slot < 0 ? NULL : t->registros + (size_t)t->indices[slot] * t->tamanho_registro;
+}
+
+// Insere (ou substitui, se a chave ja existir) e devolve o registro guardado
+static inline void* swiss_inserir(TabelaSwiss* t, const void* registro) {
+    const char* chave = (const char*)registro + t->deslocamento_chave;
+    uint64_t h = swiss_hash(chave);
+    long long existente = swiss_localizar(t, chave, h);
+    if (existente >= 0) {
+        char* destino = t->registros + (size_t)t->indices[existente] * t->tamanho_registro;
+        memcpy(destino, registro, t->tamanho_registro);
+        return destino;
+    }
+
+    // Carga maxima de 7/8 contando os apagados; se forem muitos, so limpa
+    if ((t->quantidade + t->apagados + 1) * 8 > t->capacidade * 7) {
+        size_t nova = t->capacidade;
+        if ((t->quantidade + 1) * 16 > t->capacidade * 7) nova *= 2;
+        swiss_reconstruir(t, nova);
+    }
+    if (t->quantidade == t->capacidade_registros) {
+        t->capacidade_registros *= 2;
+        t->registros = (char*)realloc(t->registros, t->capacidade_registros * t->tamanho_registro);
+        t->slot_do_registro = (uint32_t*)realloc(t->slot_do_registro, t->capacidade_registros * sizeof(uint32_t));
+        if (!t->registros || !t->slot_do_registro) {
+            fprintf(stderr, "Erro de alocacao de memoria.\n");
+            exit(1);
+        }
+    }
+
+    size_t slot = swiss_slot_livre(t, h);
+    if (t->controle[slot] == SWISS_APAGADO) t->apagados--;
+    size_t r = t->quantidade++;
+    char* destino = t->registros + r * t->tamanho_registro;
+    memcpy(destino, registro, t->tamanho_registro);
+    t->controle[slot] = (int8_t)(h & 0x7F);
+    t->indices[slot] = (uint32_t)r;
+    t->slot_do_registro[r] = (uint32_t)slot;
+    return destino;
+}
+
+// Remove a chave; o ultimo registro do array denso ocupa o lugar do removido
+static inline bool swiss_remover(TabelaSwiss* t, const char* chave) {
+    long long encontrado = swiss_localizar(t, chave, swiss_hash(chave));
+    if (encontrado < 0) return false;
+    size_t slot = (size_t)encontrado;
+
+    // Se o grupo ja tem um vazio, nenhuma sondagem passa dele: pode virar vazio
+    const int8_t* grupo = t->controle + (slot & ~(size_t)(SWISS_GRUPO - 1));
+    if (swiss_casar(grupo, SWISS_VAZIO)) {
+        t->controle[slot] = SWISS_VAZIO;
+    } else {
+        t->controle[slot] = SWISS_APAGADO;
+        t->apagados++;
+    }
+
+    size_t r = t->indices[slot];
+    size_t ultimo = --t->quantidade;
+    if (r != ultimo) {
+        memcpy(t->registros + r * t->tamanho_registro, t->registros + ultimo * t->tamanho_registro, t->tamanho_registro);
+        t->slot_do_registro[r] = t->slot_do_registro[ultimo];
+        t->indices[t->slot_do_registro[r]] = (uint32_t)r;
+    }
+    return true;
+}
+
+// Acesso direto ao array denso, para percorrer todos os registros
+static inline void* swiss_registro(const TabelaSwiss* t, size_t indice) {
+    return t->registros + indice * t->tamanho_registro;
+}
+
+static inline size_t swiss_memoria(const TabelaSwiss* t) {
+    return sizeof(*t) + t->capacidade * (sizeof(int8_t) + sizeof(uint32_t)) +
+           t->capacidade_registros * (t->tamanho_registro + sizeof(uint32_t));
+}
+
+#endif